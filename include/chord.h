@@ -6,10 +6,13 @@
 
 #include "interval.h"
 #include "note.h"
+#include "tuning.h"
 
 namespace ChordNamer {
 	class Chord : public Interval {
 	public:
+		static constexpr uint32_t MAX_QUALITY_LENGTH = QualityEvaluator<12>::MAX_QUALITY_LENGTH;
+
 		Chord() = default;
 
 		explicit Chord(const std::vector<std::string> &allNotes);
@@ -18,17 +21,36 @@ namespace ChordNamer {
 
 		explicit Chord(const std::string &line);
 
+		explicit Chord(std::span<const uint8_t> midiNotes, const Spelling &spelling = Spelling::sharps());
+
+		Chord(uint32_t pitchClassMask, uint32_t bass, const Spelling &spelling = Spelling::sharps());
+
 		Chord &reset(const std::vector<std::string> &allNotes) override;
 
 		Chord &reset(const std::string &line) override;
 
 		Chord &reset(const std::vector<Note> &allNotes) override;
 
+		Chord &reset(std::span<const uint8_t> midiNotes, const Spelling &spelling = Spelling::sharps()) override;
+
+		Chord &reset(uint32_t pitchClassMask, uint32_t bass, const Spelling &spelling = Spelling::sharps()) override;
+
 		static std::string getChordQualityFromNotes(const std::vector<Note> &allNotes, uint32_t currentRoot,
 		                                            int32_t *ranking = nullptr);
 
 		static std::string getChordQualityFromDists(const std::vector<uint32_t> &distances, int32_t *ranking = nullptr);
 
+		/*
+		Real-time safe version of getChordQualityFromDists: mask holds the distances
+		(bit k == k semitones from the root), the quality is written into buffer.
+		Never allocates nor throws; the work is bounded by the 12 pitch classes
+		(about 100 branches and at most MAX_QUALITY_LENGTH characters copied).
+		Other tunings are available through QualityEvaluator<N>.
+		Returns the length of the quality, or -1 if it does not fit in capacity.
+		*/
+		static int32_t getChordQualityFromMask(uint32_t mask, char *buffer, size_t capacity,
+		                                       int32_t *ranking = nullptr, bool *suspended = nullptr) noexcept;
+
 		std::vector<std::string> chordNames;
 
 	private:
@@ -46,13 +68,5 @@ namespace ChordNamer {
 		Sort all the chords based on their ranking (complexity) using insertion sort
 		*/
 		void insertionSortChordNames(std::vector<int32_t> &ranking);
-
-		static std::string getExtensions(bool *exist, uint32_t extStack[], const std::vector<std::string> &intervalList,
-		                                 bool isdim = false);
-
-		static bool isAltered(const bool *exist);
-
-		/* return the value of val and mark val as false */
-		static inline bool check(bool &val);
 	};
 };
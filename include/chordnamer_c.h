@@ -0,0 +1,93 @@
+#pragma once
+
+/*
+Stable C ABI of the chord namer, exported by the chordnamer_shared target.
+
+- No function throws, and the naming functions never allocate: every result is
+  written into memory owned by the caller.
+- An engine holds read-only tables once created, so a single handle can be used
+  from many threads at the same time.
+- Notes are packed into one byte each, see CHORDNAMER_PACK_NOTE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(CHORDNAMER_BUILD_SHARED)
+#    define CHORDNAMER_API __declspec(dllexport)
+#  elif defined(CHORDNAMER_USE_SHARED)
+#    define CHORDNAMER_API __declspec(dllimport)
+#  else
+#    define CHORDNAMER_API
+#  endif
+#else
+#  define CHORDNAMER_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+#  define CHORDNAMER_NOEXCEPT noexcept
+extern "C" {
+#else
+#  define CHORDNAMER_NOEXCEPT
+#endif
+
+#define CHORDNAMER_ABI_VERSION 1
+
+/* recommended size of a name slot, enough for any chord name and its '\0' */
+#define CHORDNAMER_NAME_CAPACITY 40
+
+/* maximum number of names of a single chord (one per unique note) */
+#define CHORDNAMER_MAX_NAMES 12
+
+/*
+absolute note: A == 0, A# == 1, ... , G# == 11
+accidental: -2 (bb), -1 (b), 0, 1 (#), 2 (x)
+*/
+#define CHORDNAMER_PACK_NOTE(absoluteNote, accidental) \
+	((chordnamer_note) ((((accidental) + 2) << 4) | ((absoluteNote) & 0x0F)))
+
+typedef uint8_t chordnamer_note;
+
+typedef struct chordnamer_engine chordnamer_engine;
+
+typedef enum chordnamer_status {
+	CHORDNAMER_OK = 0,
+	CHORDNAMER_ERROR_INVALID_ARGUMENT = -1,
+	CHORDNAMER_ERROR_INVALID_NOTE = -2,
+	CHORDNAMER_ERROR_BUFFER_TOO_SMALL = -3
+} chordnamer_status;
+
+CHORDNAMER_API uint32_t chordnamer_abi_version(void) CHORDNAMER_NOEXCEPT;
+
+/* returns NULL if the engine could not be created */
+CHORDNAMER_API chordnamer_engine *chordnamer_engine_create(void) CHORDNAMER_NOEXCEPT;
+
+CHORDNAMER_API void chordnamer_engine_destroy(chordnamer_engine *engine) CHORDNAMER_NOEXCEPT;
+
+/*
+Name a single chord. Up to maxNames names, sorted from the simplest to the most
+complex, are written to names (one slot of nameStride bytes per name).
+rankings (optional) receives the ranking of each name and nameCount the number of names written.
+*/
+CHORDNAMER_API chordnamer_status chordnamer_name_chord(const chordnamer_engine *engine,
+                                                       const chordnamer_note *notes, uint32_t noteCount,
+                                                       char *names, size_t nameStride, uint32_t maxNames,
+                                                       int32_t *rankings, uint32_t *nameCount) CHORDNAMER_NOEXCEPT;
+
+/*
+Name chordCount chords stored back to back in notes. Chord i is made of the notes
+in [chordOffsets[i], chordOffsets[i + 1]), so chordOffsets holds chordCount + 1 entries.
+The simplest name of chord i is written at names + i * nameStride, its ranking to
+rankings[i] (optional) and its status to statuses[i] (optional). A chord that fails
+gets an empty name.
+Returns the number of chords named successfully, or a negative chordnamer_status.
+*/
+CHORDNAMER_API int64_t chordnamer_name_batch(const chordnamer_engine *engine,
+                                             const chordnamer_note *notes, const uint32_t *chordOffsets,
+                                             size_t chordCount, char *names, size_t nameStride,
+                                             int32_t *rankings, int32_t *statuses) CHORDNAMER_NOEXCEPT;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "naming_engine.h"
+#include "note.h"
+
+namespace ChordNamer {
+	/*
+	Space-Saving heavy-hitter sketch: keeps at most capacity counters and
+	over-estimates the count of any key by at most the smallest kept count.
+	Two sketches can be merged.
+	*/
+	class HeavyHitters {
+	public:
+		struct Counter {
+			uint32_t key;
+			uint64_t count;
+			uint64_t error; //count is at most error above the true count
+		};
+
+		/* capacity is at least 1 */
+		explicit HeavyHitters(size_t capacity = 256);
+
+		void add(uint32_t key, uint64_t count = 1);
+
+		void merge(const HeavyHitters &other);
+
+		/* the k largest counters, largest first */
+		[[nodiscard]] std::vector<Counter> top(size_t k) const;
+
+	private:
+		[[nodiscard]] uint64_t minCount() const;
+
+		size_t capacity;
+		std::vector<Counter> counters;
+		std::unordered_map<uint32_t, size_t> index; //key -> position in counters
+	};
+
+	/*
+	Corpus-wide statistics over the simplest name of every chord.
+	Each thread fills its own summary, summaries are merged at the end.
+
+	Chord names are summarized by a key: quality mask (bits 0-11), packed root
+	(bits 12-19), packed bass (bits 20-27) and a slash flag (bit 28).
+	*/
+	class CorpusSummary {
+	public:
+		static constexpr uint32_t MAX_RANKING = 15;
+
+		CorpusSummary();
+
+		/* account for one named chord, previousKey is the key of the chord before it in the piece, if any */
+		void add(const PackedNote *notes, const NamingEngine::Candidate &best, const uint32_t *previousKey);
+
+		void addFailure() {
+			failures++;
+		}
+
+		void merge(const CorpusSummary &other);
+
+		static uint32_t nameKey(const PackedNote *notes, const NamingEngine::Candidate &best);
+
+		static std::string keyToName(const NamingEngine &engine, uint32_t key);
+
+		uint64_t chords = 0;
+		uint64_t failures = 0;
+		uint64_t inversions = 0; //slash chords whose bass is a chord tone
+		uint64_t slashChords = 0; //slash chords whose bass is foreign to the chord
+
+		std::vector<uint64_t> qualityCounts; //indexed by quality mask
+		std::array<uint64_t, MAX_RANKING + 1> rankingCounts{};
+		HeavyHitters topNames;
+		std::unordered_map<uint64_t, uint64_t> bigrams; //(previous key << 32 | key) -> count
+	};
+
+	class CorpusStats {
+	public:
+		/*
+		Name chordCount chords stored like in NamingEngine::nameBatch on threadCount threads.
+		pieceStarts (optional, one flag per chord) marks the first chord of each piece,
+		bigrams never cross a piece boundary. Chords of fewer than 2 notes count as failures.
+		*/
+		static CorpusSummary analyze(const NamingEngine &engine, const PackedNote *notes,
+		                             const uint32_t *chordOffsets, size_t chordCount,
+		                             const uint8_t *pieceStarts = nullptr, uint32_t threadCount = 0);
+
+		/* analyze chords [begin, end) into summary */
+		static void analyzeRange(const NamingEngine &engine, const PackedNote *notes, const uint32_t *chordOffsets,
+		                         const uint8_t *pieceStarts, size_t begin, size_t end, CorpusSummary &summary);
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ChordNamer {
+	/*
+	String with inline storage, never allocates nor throws.
+	Appending past the capacity truncates and marks the string as truncated.
+	*/
+	template<size_t Capacity>
+	class FixedString {
+	public:
+		FixedString &append(const char *str) noexcept {
+			while (*str != '\0') {
+				append(*str++);
+			}
+			return *this;
+		}
+
+		FixedString &append(const char c) noexcept {
+			if (length < Capacity) {
+				buffer[length++] = c;
+				buffer[length] = '\0';
+			} else {
+				truncated = true;
+			}
+			return *this;
+		}
+
+		template<size_t OtherCapacity>
+		FixedString &append(const FixedString<OtherCapacity> &str) noexcept {
+			return append(str.c_str());
+		}
+
+		[[nodiscard]] const char *c_str() const noexcept {
+			return buffer;
+		}
+
+		[[nodiscard]] size_t size() const noexcept {
+			return length;
+		}
+
+		[[nodiscard]] bool empty() const noexcept {
+			return length == 0;
+		}
+
+		[[nodiscard]] bool isTruncated() const noexcept {
+			return truncated;
+		}
+
+		/* copy into a caller buffer, returns the length or -1 if it does not fit (or was truncated) */
+		int32_t copyTo(char *out, const size_t capacity) const noexcept {
+			if (truncated || capacity <= length) {
+				if (capacity > 0) {
+					out[0] = '\0';
+				}
+				return -1;
+			}
+			std::memcpy(out, buffer, length + 1);
+			return static_cast<int32_t>(length);
+		}
+
+	private:
+		char buffer[Capacity + 1] = {'\0'};
+		size_t length = 0;
+		bool truncated = false;
+	};
+}
@@ -56,17 +56,20 @@ INTERVAL MACRO CONVENTIONS:
 #define A6 m7   //augmented 6th (#6)
 #define d7 M6   //diminished 7th (bb7)
 
+#include <span>
 #include <string>
 #include <vector>
 #include <cstdint>
 
 #include "note.h"
+#include "spelling.h"
 
 namespace ChordNamer {
 	class Interval {
 	protected:
 		std::vector<Note> allNotes;
 		std::vector<uint32_t> uniqueIndexes; //index in notes
+		std::vector<uint8_t> midiNotes; //MIDI number of each note, empty when the input had no register
 
 	public:
 		Interval() = default;
@@ -79,20 +82,50 @@ namespace ChordNamer {
 
 		explicit Interval(const std::vector<Note> &allNotes);
 
+		/*
+		From MIDI numbers, without any string parsing. Notes are sorted by pitch,
+		so the lowest one is the bass, and their MIDI numbers are kept in midiNotes.
+		*/
+		explicit Interval(std::span<const uint8_t> midiNotes, const Spelling &spelling = Spelling::sharps());
+
+		/*
+		From a pitch-class mask (bit 0 == A, ... , bit 11 == G#) and the absolute note of the bass,
+		which is added to the mask if missing. Notes are stacked upwards from the bass.
+		*/
+		Interval(uint32_t pitchClassMask, uint32_t bass, const Spelling &spelling = Spelling::sharps());
+
 		virtual Interval &reset(const std::string &line);
 
 		virtual Interval &reset(const std::vector<std::string> &allNotes);
 
 		virtual Interval &reset(const std::vector<Note> &allNotes);
 
+		virtual Interval &reset(std::span<const uint8_t> midiNotes, const Spelling &spelling = Spelling::sharps());
+
+		virtual Interval &reset(uint32_t pitchClassMask, uint32_t bass, const Spelling &spelling = Spelling::sharps());
+
+		[[nodiscard]] const std::vector<uint8_t> &getMidiNotes() const {
+			return midiNotes;
+		}
+
+		[[nodiscard]] uint32_t getPitchClassMask() const;
+
 		/*
 		Process the all the distances from the current root and output the interval list
 		*/
 		static std::vector<std::string> getIntervalList(const std::vector<uint32_t> &distances, bool chordMode = false);
 
+		/*
+		Same as getIntervalList, from a mask of distances (bit k == k semitones from the root).
+		Writes pointers to string literals, so it never allocates.
+		*/
+		static void getIntervalNames(uint32_t mask, const char *names[12], bool chordMode = false) noexcept;
+
 	private:
 		static std::vector<std::string> distancesToIntervals(const std::vector<uint32_t> &distances);
 
 		void split(const std::string &line);
+
+		void updateUniqueIndexes();
 	};
 }
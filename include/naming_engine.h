@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "note.h"
+#include "quality_table.h"
+#include "ranking.h"
+
+namespace ChordNamer {
+	/*
+	Allocation-free counterpart of Chord: names packed notes using a precomputed
+	QualityTable and writes the results into caller-owned memory.
+	All const member functions are reentrant, so one engine can be shared by many threads.
+	Candidates are ordered by a compile-time ranking Policy (see ranking.h).
+	*/
+	class NamingEngine {
+	public:
+		static constexpr uint32_t MAX_CANDIDATES = 12;
+		static constexpr uint32_t MAX_NAME_LENGTH = 40; //root + quality + "/" + bass + '\0'
+
+		enum Status {
+			OK = 0, INVALID_ARGUMENT = -1, INVALID_NOTE = -2, BUFFER_TOO_SMALL = -3
+		};
+
+		struct Candidate {
+			uint16_t mask; //quality table index (distances from the root)
+			uint8_t length; //length of the formatted name, without '\0'
+			uint32_t root; //index of the root in the input notes, which may hold any number of notes
+			int32_t ranking;
+		};
+
+		NamingEngine() = default;
+
+		/*
+		Evaluate every inversion of the chord and sort them by Policy
+		(like Chord::chordNames with DefaultRanking).
+		Returns the number of candidates written to out, or a negative Status
+		*/
+		template<RankingPolicy Policy = DefaultRanking>
+		int32_t evaluate(const PackedNote *notes, size_t count, Candidate out[MAX_CANDIDATES]) const noexcept;
+
+		/* write the name of candidate into buffer, returns its length or a negative Status */
+		int32_t format(const PackedNote *notes, const Candidate &candidate, char *buffer,
+		               size_t capacity) const noexcept;
+
+		/*
+		Name chordCount chords stored back to back in notes, chord i being
+		[chordOffsets[i], chordOffsets[i + 1]). Only the simplest name of each chord is
+		written, at names + i * nameStride; rankings and statuses are optional.
+		Returns the number of chords named successfully.
+		*/
+		template<RankingPolicy Policy = DefaultRanking>
+		size_t nameBatch(const PackedNote *notes, const uint32_t *chordOffsets, size_t chordCount, char *names,
+		                 size_t nameStride, int32_t *rankings = nullptr, int32_t *statuses = nullptr) const noexcept;
+
+		[[nodiscard]] const QualityTable &getQualityTable() const {
+			return table;
+		}
+
+		/*
+		Real-time safe naming that needs no engine: no table, no allocation, no exception,
+		only fixed-capacity storage on the stack. Qualities are computed on the fly with
+		QualityEvaluator<12> (like Chord::getChordQualityFromMask).
+		Writes up to maxNames names (one slot of nameStride bytes each, sorted by Policy)
+		and returns the number written, or a negative Status.
+
+		Worst case, for n notes: one validation pass over the n notes, then at most 12
+		candidates, each costing 2 quality evaluations (full and rootless); at most 66
+		swaps of the insertion sort; and one quality evaluation plus at most
+		MAX_NAME_LENGTH bytes copied per written name. That is at most 36 quality
+		evaluations per chord, whatever the input.
+		*/
+		template<RankingPolicy Policy = DefaultRanking>
+		static int32_t nameRealtime(const PackedNote *notes, size_t count, char *names, size_t nameStride,
+		                            uint32_t maxNames, int32_t *rankings = nullptr) noexcept;
+
+	private:
+		QualityTable table;
+	};
+}
+
+#include "naming_engine_impl.h"
@@ -0,0 +1,256 @@
+#pragma once
+
+/*
+Template part of NamingEngine, included by naming_engine.h so that any ranking
+policy, including ones defined outside the library, can be used.
+*/
+
+#include <cstring>
+
+#include "tuning.h"
+
+namespace ChordNamer::detail {
+	using Candidate = NamingEngine::Candidate;
+
+	//letter of each absolute note without accidental, '\0' when the note needs one
+	inline constexpr char naturalLetters[12] = {'A', '\0', 'B', 'C', '\0', 'D', '\0', 'E', 'F', '\0', 'G', '\0'};
+
+	constexpr uint32_t rotateMask(const uint32_t mask, const uint32_t shift) {
+		return ((mask >> shift) | (mask << (12 - shift))) & 0xFFF;
+	}
+
+	constexpr uint32_t absoluteNoteOf(const PackedNote note) {
+		return note & 0x0F;
+	}
+
+	constexpr int32_t accidentalOf(const PackedNote note) {
+		return (note >> 4) - 2;
+	}
+
+	inline uint32_t writeNoteName(const PackedNote note, char *buffer) {
+		const int32_t accidental = accidentalOf(note);
+		uint32_t pos = 0;
+
+		buffer[pos++] = naturalLetters[(absoluteNoteOf(note) - accidental + 12) % 12];
+
+		switch (accidental) {
+			case Note::SHARP:
+				buffer[pos++] = '#';
+				break;
+			case Note::FLAT:
+				buffer[pos++] = 'b';
+				break;
+			case Note::DOUBLE_SHARP:
+				buffer[pos++] = 'x';
+				break;
+			case Note::DOUBLE_FLAT:
+				buffer[pos++] = 'b';
+				buffer[pos++] = 'b';
+				break;
+			case Note::NATURAL:
+			default:
+				break;
+		}
+		return pos;
+	}
+
+	inline uint32_t noteNameLength(const PackedNote note) {
+		return 1 + ((accidentalOf(note) == Note::DOUBLE_FLAT) ? 2 : (accidentalOf(note) != Note::NATURAL));
+	}
+
+	/* quality part of the features, the caller fills in the rest */
+	inline NameFeatures qualityFeatures(const uint32_t length, const int32_t ranking, const bool suspended) {
+		return {static_cast<uint32_t>(ranking - suspended), suspended, false, false, false, length, 0};
+	}
+
+	/*
+	Evaluate every inversion of the chord, qualityOf(mask) gives the features of a quality.
+	Loops are bounded by the note count (one pass) and by the 12 possible candidates.
+	*/
+	template<typename Policy, typename QualityOf>
+	int32_t evaluateCandidates(const PackedNote *notes, const size_t count, Candidate out[], QualityOf &&qualityOf) {
+		if (notes == nullptr || out == nullptr || count == 0) {
+			return NamingEngine::INVALID_ARGUMENT;
+		}
+
+		uint32_t fullMask = 0;
+		uint32_t restMask = 0; //every note except the bass, used for the rootless variant
+		uint32_t candidateCount = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			if (!Note::validate(notes[i])) {
+				return NamingEngine::INVALID_NOTE;
+			}
+			const uint32_t bit = 1u << absoluteNoteOf(notes[i]);
+			if (i != 0) {
+				restMask |= bit;
+			}
+			if (!(fullMask & bit)) {
+				fullMask |= bit;
+				out[candidateCount++].root = static_cast<uint32_t>(i);
+			}
+		}
+
+		const uint32_t bass = absoluteNoteOf(notes[0]);
+		const uint32_t bassLength = noteNameLength(notes[0]);
+		uint32_t ties[NamingEngine::MAX_CANDIDATES];
+
+		for (uint32_t c = 0; c < candidateCount; c++) {
+			Candidate &candidate = out[c];
+			const uint32_t shift = absoluteNoteOf(notes[candidate.root]);
+
+			uint32_t mask = rotateMask(fullMask, shift);
+			NameFeatures features = qualityOf(mask);
+			features.nameLength = noteNameLength(notes[candidate.root]) + features.qualityLength;
+
+			if (candidate.root != 0) {
+				//not in root position (slash chord)
+				const uint32_t bassBit = 1u << ((bass + 12 - shift) % 12);
+				features.slash = true;
+				features.inversion = (mask & bassBit) != 0;
+				features.nameLength += 1 + bassLength;
+
+				if (count > 1) {
+					// the policy decides between the full and the rootless quality
+					const uint32_t rootlessMask = rotateMask(restMask, shift);
+					NameFeatures rootless = qualityOf(rootlessMask);
+					rootless.slash = true;
+					rootless.inversion = (rootlessMask & bassBit) != 0;
+					rootless.rootless = true;
+					rootless.nameLength = features.nameLength - features.qualityLength + rootless.qualityLength;
+					if (Policy::preferRootless(features, rootless)) {
+						mask = rootlessMask;
+						features = rootless;
+					}
+				}
+			}
+
+			candidate.mask = static_cast<uint16_t>(mask);
+			candidate.ranking = Policy::rank(features);
+			candidate.length = static_cast<uint8_t>(features.nameLength);
+			ties[c] = Policy::tieBreak(features);
+		}
+
+		//insertion sort by ranking, the policy breaks ties (name sizes for DefaultRanking)
+		for (uint32_t i = 1; i < candidateCount; i++) {
+			for (uint32_t j = i; j > 0; j--) {
+				if ((out[j].ranking == out[j - 1].ranking && ties[j] < ties[j - 1])
+				    || (out[j].ranking < out[j - 1].ranking)) {
+					const Candidate tmp = out[j];
+					out[j] = out[j - 1];
+					out[j - 1] = tmp;
+					const uint32_t tie = ties[j];
+					ties[j] = ties[j - 1];
+					ties[j - 1] = tie;
+				} else {
+					break;
+				}
+			}
+		}
+
+		return static_cast<int32_t>(candidateCount);
+	}
+
+	/* root + quality + optional "/bass", the caller checked that the name fits */
+	inline int32_t writeName(const PackedNote *notes, const Candidate &candidate, const char *quality,
+	                  const uint32_t qualityLength, char *buffer) {
+		uint32_t pos = writeNoteName(notes[candidate.root], buffer);
+
+		std::memcpy(buffer + pos, quality, qualityLength);
+		pos += qualityLength;
+
+		if (candidate.root != 0) {
+			buffer[pos++] = '/';
+			pos += writeNoteName(notes[0], buffer + pos);
+		}
+
+		buffer[pos] = '\0';
+		return static_cast<int32_t>(pos);
+	}
+}
+
+template<ChordNamer::RankingPolicy Policy>
+int32_t ChordNamer::NamingEngine::evaluate(const PackedNote *notes, const size_t count,
+                                           Candidate out[MAX_CANDIDATES]) const noexcept {
+	return detail::evaluateCandidates<Policy>(notes, count, out, [this](const uint32_t mask) {
+		return detail::qualityFeatures(table.length(mask), table.ranking(mask), table.suspended(mask));
+	});
+}
+
+template<ChordNamer::RankingPolicy Policy>
+size_t ChordNamer::NamingEngine::nameBatch(const PackedNote *notes, const uint32_t *chordOffsets,
+                                           const size_t chordCount, char *names, const size_t nameStride,
+                                           int32_t *rankings, int32_t *statuses) const noexcept {
+	Candidate candidates[MAX_CANDIDATES];
+	size_t named = 0;
+
+	for (size_t i = 0; i < chordCount; i++) {
+		const uint32_t begin = chordOffsets[i];
+		const uint32_t end = chordOffsets[i + 1];
+		char *name = names + i * nameStride;
+
+		int32_t status = INVALID_ARGUMENT;
+		if (end > begin) {
+			status = evaluate<Policy>(notes + begin, end - begin, candidates);
+			if (status > 0) {
+				status = format(notes + begin, candidates[0], name, nameStride);
+			}
+		}
+
+		if (status >= 0) {
+			named++;
+			status = OK;
+		} else if (nameStride > 0) {
+			name[0] = '\0';
+		}
+
+		if (rankings != nullptr) {
+			rankings[i] = (status == OK) ? candidates[0].ranking : -1;
+		}
+		if (statuses != nullptr) {
+			statuses[i] = status;
+		}
+	}
+
+	return named;
+}
+
+template<ChordNamer::RankingPolicy Policy>
+int32_t ChordNamer::NamingEngine::nameRealtime(const PackedNote *notes, const size_t count, char *names,
+                                               const size_t nameStride, const uint32_t maxNames,
+                                               int32_t *rankings) noexcept {
+	if (names == nullptr && maxNames > 0) {
+		return INVALID_ARGUMENT;
+	}
+
+	char quality[QualityEvaluator<12>::MAX_QUALITY_LENGTH + 1];
+	Candidate candidates[MAX_CANDIDATES];
+
+	auto qualityOf = [&quality](const uint32_t mask) {
+		int32_t ranking;
+		bool suspended;
+		const int32_t length = QualityEvaluator<12>::evaluate(static_cast<uint16_t>(mask), quality, sizeof(quality),
+		                                                      &ranking, &suspended);
+		return detail::qualityFeatures(static_cast<uint32_t>(length), ranking, suspended);
+	};
+
+	const int32_t candidateCount = detail::evaluateCandidates<Policy>(notes, count, candidates, qualityOf);
+	if (candidateCount < 0) {
+		return candidateCount;
+	}
+
+	const uint32_t written = (static_cast<uint32_t>(candidateCount) < maxNames) ? candidateCount : maxNames;
+	for (uint32_t i = 0; i < written; i++) {
+		if (nameStride <= candidates[i].length) {
+			return BUFFER_TOO_SMALL;
+		}
+		const int32_t length = QualityEvaluator<12>::evaluate(candidates[i].mask, quality, sizeof(quality));
+		detail::writeName(notes, candidates[i], quality, length, names + i * nameStride);
+
+		if (rankings != nullptr) {
+			rankings[i] = candidates[i].ranking;
+		}
+	}
+
+	return static_cast<int32_t>(written);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "naming_engine.h"
+#include "spelling.h"
+#include "spsc_ring.h"
+
+namespace ChordNamer {
+	/*
+	Lock-free pipeline from a MIDI input thread to a naming worker and to the UI.
+
+	The input thread pushes note events into a wait-free SPSC ring. The worker drains
+	every pending event, updates the set of held notes and names it once per drain
+	with the NamingEngine (no lock, no allocation). Each result goes both into a
+	second SPSC ring, for a consumer that needs every result, and into a
+	latest-value slot for a UI that only shows the current chord.
+	No thread ever waits for another: a full ring drops the new entry and counts it.
+	*/
+	class NamingPipeline {
+	public:
+		static constexpr size_t EVENT_CAPACITY = 1024;
+		static constexpr size_t RESULT_CAPACITY = 256;
+
+		struct NoteEvent {
+			uint64_t timestamp; //any clock of the caller's choice, carried to the result
+			uint8_t note; //MIDI note number
+			uint8_t velocity; //0 == note off
+		};
+
+		struct Result {
+			uint64_t sequence; //1 for the first result
+			uint64_t timestamp; //of the oldest event this result accounts for
+			int32_t ranking; //-1 when no note is held
+			uint32_t noteCount; //held notes
+			char name[NamingEngine::MAX_NAME_LENGTH]; //empty when no note is held
+		};
+
+		explicit NamingPipeline(const NamingEngine &engine, const Spelling &spelling = Spelling::sharps());
+
+		~NamingPipeline();
+
+		NamingPipeline(const NamingPipeline &) = delete;
+
+		NamingPipeline &operator=(const NamingPipeline &) = delete;
+
+		/* input thread: never blocks, returns false if the event queue is full (the event is dropped) */
+		bool push(const NoteEvent &event) noexcept {
+			return events.tryPush(event);
+		}
+
+		/* result consumer thread: every result in order, false when there is none */
+		bool pop(Result &result) noexcept {
+			return results.tryPop(result);
+		}
+
+		/* UI thread: most recent result, false (result untouched) if nothing changed since the last call */
+		bool latest(Result &result) noexcept {
+			return latestResult.poll(result);
+		}
+
+		/*
+		Worker step: drain the pending events and publish one result if any arrived.
+		Returns the number of events processed. Only call it from a single thread,
+		and not while the worker started by start() is running.
+		*/
+		size_t process() noexcept;
+
+		/* run process() on a dedicated worker thread until stop() */
+		void start();
+
+		void stop();
+
+		/* results lost because the result ring was full */
+		[[nodiscard]] uint64_t droppedResults() const noexcept {
+			return dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		void run() noexcept;
+
+		const NamingEngine &engine;
+		const Spelling spelling;
+
+		SpscRing<NoteEvent, EVENT_CAPACITY> events;
+		SpscRing<Result, RESULT_CAPACITY> results;
+		LatestValue<Result> latestResult;
+
+		//worker state
+		uint64_t held[2] = {0, 0}; //one bit per MIDI note
+		uint64_t sequence = 0;
+
+		std::atomic<uint64_t> dropped{0};
+		std::atomic<bool> running{false};
+		std::thread worker;
+	};
+}
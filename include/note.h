@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 
@@ -20,6 +21,13 @@
 */
 
 namespace ChordNamer {
+	/*
+	Packed note layout (one byte per note):
+	  bits 0-3 : absolute note (A == 0, A# == 1, ... , G# == 11)
+	  bits 4-6 : accidental + 2 (DOUBLE_FLAT == 0, ... , DOUBLE_SHARP == 4)
+	*/
+	using PackedNote = uint8_t;
+
 	class Note {
 	public:
 		enum Accidental {
@@ -28,6 +36,21 @@ namespace ChordNamer {
 
 		explicit Note(const std::string &str, Accidental preferredAccidental = SHARP);
 
+		Note(int32_t absoluteNote, Accidental accidental, Accidental preferredAccidental = SHARP);
+
+		static constexpr PackedNote pack(const uint32_t absoluteNote, const Accidental accidental) {
+			return static_cast<PackedNote>(((accidental + 2) << 4) | (absoluteNote & 0x0F));
+		}
+
+		[[nodiscard]] PackedNote pack() const {
+			return pack(absoluteNote, accidental);
+		}
+
+		static Note unpack(PackedNote packed, Accidental preferredAccidental = SHARP);
+
+		/* overwrite this note with a packed one, keeping the preferred accidental */
+		Note &assign(PackedNote packed);
+
 		Note &shiftSemitone(int32_t semitones, Accidental defaultAccidental = NATURAL);
 
 		Note &respell();
@@ -38,6 +61,20 @@ namespace ChordNamer {
 
 		static bool validate(const std::string &strNote);
 
+		static bool validate(PackedNote packed);
+
+		/*
+		Parse a note written like in Note(const std::string &) into packed,
+		without allocating or throwing. Returns false if the note is invalid.
+		*/
+		static bool parse(std::string_view str, PackedNote &packed) noexcept;
+
+		/*
+		Append the notes of a list separated by spaces, commas or tabs ("C E G", "C,E,G")
+		to notes. Returns false, leaving notes as they were, if a note is invalid.
+		*/
+		static bool parseList(std::string_view str, std::vector<PackedNote> &notes);
+
 		//distance between two notes in terms of semitone count
 		[[nodiscard]] uint32_t getDistanceTo(const Note &right) const;
 
@@ -47,14 +84,13 @@ namespace ChordNamer {
 
 		static std::vector<uint32_t> getUniqueIndexes(const std::vector<Note> &allNotes);
 
-	private:
-		void updateString();
+		//set of absolute notes present (bit 0 == A, ... , bit 11 == G#)
+		static uint32_t getPitchClassMask(const std::vector<Note> &allNotes);
 
+	private:
 		int32_t absoluteNote; // A == 0, A# == 1, ... , G# == 11
 
 		Accidental accidental;
 		Accidental preferredAccidental; //the default accidental to use when not provided any
-
-		std::string strNote;
 	};
 }
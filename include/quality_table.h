@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ChordNamer {
+	/*
+	Every chord quality only depends on the set of semitone distances from the
+	current root, so all of them fit in a table indexed by a 12-bit mask
+	(bit k set == a note k semitones above the root is present).
+	The table is built once from Chord::getChordQualityFromMask.
+	*/
+	class QualityTable {
+	public:
+		static constexpr uint32_t MASK_COUNT = 4096;
+		static constexpr uint32_t STRIDE = 32; //Chord::MAX_QUALITY_LENGTH + '\0'
+
+		QualityTable();
+
+		[[nodiscard]] const char *quality(const uint32_t mask) const {
+			return &qualities[mask * STRIDE];
+		}
+
+		[[nodiscard]] uint32_t length(const uint32_t mask) const {
+			return lengths[mask];
+		}
+
+		[[nodiscard]] int32_t ranking(const uint32_t mask) const {
+			return rankings[mask];
+		}
+
+		[[nodiscard]] bool suspended(const uint32_t mask) const {
+			return suspensions[mask];
+		}
+
+	private:
+		std::vector<char> qualities;
+		std::vector<uint8_t> lengths;
+		std::vector<int8_t> rankings;
+		std::vector<uint8_t> suspensions;
+	};
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace ChordNamer {
+	/* what a ranking policy can look at, all known before any name is formatted */
+	struct NameFeatures {
+		uint32_t additional; //intervals listed after the quality (add9, b5, (omit3), ...)
+		bool suspended; //sus2 or sus4
+		bool slash; //the bass is not the root
+		bool inversion; //slash chord whose bass is a chord tone
+		bool rootless; //quality of the notes above the bass only
+		uint32_t qualityLength;
+		uint32_t nameLength; //root + quality + "/" + bass
+	};
+
+	/*
+	Ranking policies for NamingEngine, chosen at compile time (no virtual dispatch).
+	A policy is a type providing:
+	  static int32_t rank(const NameFeatures &)  -- the lower the simpler
+	  static bool preferRootless(const NameFeatures &full, const NameFeatures &rootless)
+	  static uint32_t tieBreak(const NameFeatures &)  -- equal ranks: lower first
+	Policies can be defined anywhere, the engine templates live in headers.
+	*/
+	template<typename Policy>
+	concept RankingPolicy = requires(const NameFeatures &features) {
+		{ Policy::rank(features) } -> std::same_as<int32_t>;
+		{ Policy::preferRootless(features, features) } -> std::same_as<bool>;
+		{ Policy::tieBreak(features) } -> std::same_as<uint32_t>;
+	};
+
+	/* same ordering as Chord::chordNames */
+	struct DefaultRanking {
+		static constexpr int32_t rank(const NameFeatures &features) {
+			return static_cast<int32_t>(features.additional) + features.suspended + features.slash;
+		}
+
+		static constexpr bool preferRootless(const NameFeatures &full, const NameFeatures &rootless) {
+			return rootless.qualityLength < full.qualityLength;
+		}
+
+		static constexpr uint32_t tieBreak(const NameFeatures &features) {
+			return features.nameLength;
+		}
+	};
+
+	/* reads the notes above the bass as the chord whenever that name is not more complex */
+	struct RootlessRanking : DefaultRanking {
+		static constexpr bool preferRootless(const NameFeatures &full, const NameFeatures &rootless) {
+			return rank(rootless) <= rank(full);
+		}
+	};
+
+	/* pop charts: few extensions, inversions over foreign basses */
+	struct PopRanking {
+		static constexpr int32_t rank(const NameFeatures &features) {
+			return 2 * static_cast<int32_t>(features.additional) + features.suspended
+			       + (features.slash ? (features.inversion ? 1 : 2) : 0);
+		}
+
+		static constexpr bool preferRootless(const NameFeatures &full, const NameFeatures &rootless) {
+			return rank(rootless) < rank(full);
+		}
+
+		static constexpr uint32_t tieBreak(const NameFeatures &features) {
+			return features.nameLength;
+		}
+	};
+
+	/* jazz charts: sus is ordinary, slash names are avoided, the shortest quality wins ties */
+	struct JazzRanking {
+		static constexpr int32_t rank(const NameFeatures &features) {
+			return static_cast<int32_t>(features.additional) + 2 * features.slash;
+		}
+
+		static constexpr bool preferRootless(const NameFeatures &full, const NameFeatures &rootless) {
+			return rank(rootless) <= rank(full);
+		}
+
+		static constexpr uint32_t tieBreak(const NameFeatures &features) {
+			return features.qualityLength;
+		}
+	};
+
+	static_assert(RankingPolicy<DefaultRanking>);
+	static_assert(RankingPolicy<RootlessRanking>);
+	static_assert(RankingPolicy<PopRanking>);
+	static_assert(RankingPolicy<JazzRanking>);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "naming_engine.h"
+#include "spelling.h"
+
+namespace ChordNamer {
+	/*
+	Lowest-cost chord path under melody and bass constraints (Viterbi search).
+
+	States are pitch-class masks (bit 0 == A, ... , bit 11 == G#) from a vocabulary of
+	nameable chords. The cost of a path sums, for each step, the ranking of the
+	chord name and the voice-leading distance from the previous chord. The search
+	keeps only the beamWidth best states per step.
+	*/
+	class Reharmonizer {
+	public:
+		struct Options {
+			uint32_t minNotes = 3;
+			uint32_t maxNotes = 4;
+			int32_t maxRanking = 1; //chords with a more complex simplest name are left out
+			uint32_t rankingWeight = 2;
+			uint32_t voiceLeadingWeight = 1;
+			uint32_t beamWidth = 64; //at most 65535
+		};
+
+		/* absolute notes (A == 0), -1 when unconstrained */
+		struct Target {
+			int32_t melody = -1; //has to be in the chord
+			int32_t bass = -1; //has to be the bass of the chord
+		};
+
+		struct Step {
+			uint32_t mask;
+			int32_t bass; //absolute note of the bass
+			uint32_t cost; //accumulated cost up to this step
+		};
+
+		explicit Reharmonizer(const NamingEngine &engine);
+
+		Reharmonizer(const NamingEngine &engine, const Options &options);
+
+		/* one step per target, empty if some target cannot be harmonized */
+		[[nodiscard]] std::vector<Step> solve(const std::vector<Target> &targets) const;
+
+		[[nodiscard]] std::string name(const Step &step, const Spelling &spelling = Spelling::sharps()) const;
+
+		/*
+		Sum over the notes of each chord of the distance in semitones to the nearest
+		note of the other chord, computed with bit operations only (0 if a chord is empty).
+		*/
+		static uint32_t voiceLeadingCost(uint32_t from, uint32_t to);
+
+	private:
+		/*
+		A chord of at least 2 notes is never more than 5 semitones away from any note,
+		so the distances from one chord are fully described by 5 dilations (grown by
+		0..4 semitones on both sides) and fit in one 64-bit word, 12 bits each.
+		*/
+		static constexpr uint32_t DILATIONS = 5;
+
+		struct State {
+			uint64_t replicated; //the mask repeated DILATIONS times
+			uint64_t notDilated; //complement of each dilation
+			uint16_t mask;
+			int8_t bestBass; //absolute note of the bass giving the simplest name
+			int8_t bestRanking;
+		};
+
+		static State makeState(uint32_t mask);
+
+		const NamingEngine &engine;
+		Options options;
+
+		std::vector<State> vocabulary;
+		std::vector<std::array<int8_t, 12> > bassRankings; //ranking with each note as bass, -1 if not in the chord
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ChordNamer {
+	/*
+	Catalog of scales and modes, and a precomputed table answering
+	"which scales, in which of the 12 keys, contain this set of notes".
+
+	The table has one row per pitch-class mask (bit 0 == A, ... , bit 11 == G#,
+	see Note::getPitchClassMask) and one bit per (scale, key) pair:
+	bit scale * 12 + key, key being the absolute note of the tonic (A == 0).
+	*/
+	class ScaleMembership {
+	public:
+		struct Scale {
+			const char *name;
+			uint32_t intervals; //semitones above the tonic, bit 0 == tonic
+		};
+
+		static constexpr uint32_t SCALE_COUNT = 16;
+		static constexpr uint32_t KEY_COUNT = 12;
+		static constexpr uint32_t MASK_COUNT = 4096;
+
+		using ScaleSet = std::bitset<SCALE_COUNT * KEY_COUNT>;
+
+		static const Scale catalog[SCALE_COUNT];
+
+		ScaleMembership();
+
+		/* single row lookup */
+		[[nodiscard]] const ScaleSet &lookup(const uint32_t pitchClassMask) const {
+			return table[pitchClassMask & (MASK_COUNT - 1)];
+		}
+
+		/* one lookup per chord of a progression */
+		void lookup(const uint32_t *pitchClassMasks, size_t count, ScaleSet *out) const;
+
+		/* scales and keys containing every chord of a progression */
+		[[nodiscard]] ScaleSet common(const uint32_t *pitchClassMasks, size_t count) const;
+
+		static bool contains(const ScaleSet &scales, uint32_t scale, uint32_t key) {
+			return scales.test(scale * KEY_COUNT + key);
+		}
+
+	private:
+		std::vector<ScaleSet> table;
+	};
+}
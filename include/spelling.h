@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+
+#include "note.h"
+
+namespace ChordNamer {
+	/*
+	Spelling policy: the packed note to use for each of the 12 absolute notes.
+	Respelling a note is a single table lookup.
+	*/
+	class Spelling {
+	public:
+		/* every black key spelled with the given accidental, white keys natural */
+		static constexpr Spelling uniform(const Note::Accidental blackKeyAccidental) {
+			Spelling spelling;
+			for (uint32_t i = 0; i < 12; i++) {
+				spelling.table[i] = Note::pack(i, isNatural[i] ? Note::NATURAL : blackKeyAccidental);
+			}
+			return spelling;
+		}
+
+		static constexpr Spelling sharps() {
+			return uniform(Note::SHARP);
+		}
+
+		static constexpr Spelling flats() {
+			return uniform(Note::FLAT);
+		}
+
+		/*
+		Spelling of the key whose tonic is the given absolute note (A == 0).
+		Diatonic notes follow the key signature, chromatic notes use the direction
+		of the key signature (sharps or flats). Minor keys use the signature of
+		their relative major and spell the leading tone as a raised 7th.
+		*/
+		static constexpr Spelling forKey(const uint32_t tonic, const bool minor = false) {
+			const uint32_t majorTonic = (tonic + (minor ? 3 : 0)) % 12;
+			const uint32_t tonicLetter = majorTonicLetters[majorTonic];
+
+			Spelling spelling = sharps();
+			bool flatKey = false;
+			bool diatonic[12] = {false};
+
+			for (uint32_t degree = 0; degree < 7; degree++) {
+				const uint32_t absolute = (majorTonic + majorScale[degree]) % 12;
+				const uint32_t letter = (tonicLetter + degree) % 7;
+				const Note::Accidental accidental = accidentalBetween(letter, absolute);
+
+				spelling.table[absolute] = Note::pack(absolute, accidental);
+				diatonic[absolute] = true;
+				flatKey = flatKey || accidental < Note::NATURAL;
+			}
+
+			for (uint32_t i = 0; i < 12; i++) {
+				if (!diatonic[i]) {
+					const Note::Accidental chromatic = flatKey ? Note::FLAT : Note::SHARP;
+					spelling.table[i] = Note::pack(i, isNatural[i] ? Note::NATURAL : chromatic);
+				}
+			}
+
+			if (minor) {
+				//leading tone: raised 7th degree, one letter below the minor tonic
+				//(which is itself two letters below the relative major tonic)
+				const uint32_t leadingTone = (tonic + 11) % 12;
+				const uint32_t letter = (tonicLetter + 4) % 7;
+				spelling.table[leadingTone] = Note::pack(leadingTone, accidentalBetween(letter, leadingTone));
+			}
+
+			return spelling;
+		}
+
+		[[nodiscard]] constexpr PackedNote spell(const uint32_t absoluteNote) const {
+			return table[absoluteNote];
+		}
+
+		PackedNote table[12] = {};
+
+	private:
+		static constexpr bool isNatural[12] = {
+			true, false, true, true, false, true, false, true, true, false, true, false
+		};
+
+		static constexpr uint32_t letterToAbsolute[7] = {0 /*A*/, 2 /*B*/, 3 /*C*/, 5 /*D*/, 7 /*E*/, 8 /*F*/, 10 /*G*/};
+
+		//letter of the tonic of each major key: A Bb B C Db D Eb E F F# G Ab
+		static constexpr uint32_t majorTonicLetters[12] = {0, 1, 1, 2, 3, 3, 4, 4, 5, 5, 6, 0};
+
+		static constexpr uint32_t majorScale[7] = {0, 2, 4, 5, 7, 9, 11};
+
+		static constexpr Note::Accidental accidentalBetween(const uint32_t letter, const uint32_t absolute) {
+			int32_t diff = static_cast<int32_t>(absolute) - static_cast<int32_t>(letterToAbsolute[letter]);
+			if (diff > 6) diff -= 12;
+			if (diff < -6) diff += 12;
+			return static_cast<Note::Accidental>(diff);
+		}
+	};
+}
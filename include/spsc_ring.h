@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ChordNamer {
+	constexpr size_t CACHE_LINE_SIZE = 64;
+
+	/*
+	Wait-free single-producer single-consumer ring buffer holding up to Capacity
+	values (a power of two). tryPush may only be called from one thread and tryPop
+	from one other thread; both finish in a bounded number of steps, never block
+	and never allocate. Each side keeps a cached copy of the other side's index,
+	so the shared cache lines are only read when the ring looks full or empty.
+	*/
+	template<typename T, size_t Capacity>
+	class SpscRing {
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+		static_assert(std::is_trivially_copyable_v<T>, "values are copied in and out of the ring");
+
+	public:
+		/* producer only, returns false (and drops nothing) when the ring is full */
+		bool tryPush(const T &value) noexcept {
+			const size_t position = tail.load(std::memory_order_relaxed);
+			if (position - cachedHead == Capacity) {
+				cachedHead = head.load(std::memory_order_acquire);
+				if (position - cachedHead == Capacity) {
+					return false;
+				}
+			}
+			slots[position & (Capacity - 1)] = value;
+			tail.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/* consumer only, returns false when the ring is empty */
+		bool tryPop(T &value) noexcept {
+			const size_t position = head.load(std::memory_order_relaxed);
+			if (position == cachedTail) {
+				cachedTail = tail.load(std::memory_order_acquire);
+				if (position == cachedTail) {
+					return false;
+				}
+			}
+			value = slots[position & (Capacity - 1)];
+			head.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/* approximate when called while the other side is running */
+		[[nodiscard]] size_t size() const noexcept {
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+		}
+
+	private:
+		//indexes run freely and are masked on access, each one on its own cache line
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0}; //next slot to read, written by the consumer
+		size_t cachedTail = 0; //consumer's view of tail
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0}; //next slot to write, written by the producer
+		size_t cachedHead = 0; //producer's view of head
+		alignas(CACHE_LINE_SIZE) T slots[Capacity];
+	};
+
+	/*
+	Latest-value publication slot (triple buffer): one writer publishes values, one
+	reader picks up the most recent one. Both sides are wait-free, the writer never
+	waits for a slow reader and intermediate values are simply overwritten.
+	*/
+	template<typename T>
+	class LatestValue {
+		static_assert(std::is_trivially_copyable_v<T>, "values are copied in and out of the slot");
+
+	public:
+		/* writer only */
+		void publish(const T &value) noexcept {
+			buffers[back] = value;
+			back = state.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+		}
+
+		/* reader only, returns false (value untouched) if nothing was published since the last call */
+		bool poll(T &value) noexcept {
+			if (!(state.load(std::memory_order_relaxed) & FRESH)) {
+				return false;
+			}
+			front = state.exchange(front, std::memory_order_acq_rel) & INDEX;
+			value = buffers[front];
+			return true;
+		}
+
+	private:
+		static constexpr uint8_t INDEX = 0x03;
+		static constexpr uint8_t FRESH = 0x04; //the middle buffer has not been read yet
+
+		T buffers[3] = {};
+		alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> state{1}; //index of the middle buffer | FRESH
+		alignas(CACHE_LINE_SIZE) uint8_t back = 0; //owned by the writer
+		alignas(CACHE_LINE_SIZE) uint8_t front = 2; //owned by the reader
+	};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "naming_engine.h"
+#include "note.h"
+#include "spelling.h"
+
+namespace ChordNamer {
+	/*
+	Bulk operations over contiguous arrays of packed notes.
+	Every function is a single table-driven pass and never allocates.
+	An invalid note (see Note::validate) comes out invalid.
+	*/
+	class Transposition {
+	public:
+		/* shift every note by semitones and spell it with the given policy, in and out may alias */
+		static void transpose(const PackedNote *in, PackedNote *out, size_t count, int32_t semitones,
+		                      const Spelling &spelling);
+
+		/* shift every note by semitones, keeping the accidental direction of each note (like Note::shiftSemitone) */
+		static void transpose(const PackedNote *in, PackedNote *out, size_t count, int32_t semitones);
+
+		static void respell(PackedNote *notes, size_t count, const Spelling &spelling);
+
+		/*
+		Transpose chords stored like in chordnamer_name_batch (chordOffsets holds chordCount + 1
+		entries) into transposed, then write the simplest name of each transposed chord at
+		names + i * nameStride. Returns the number of chords named successfully.
+		*/
+		static size_t transposeAndName(const NamingEngine &engine, const PackedNote *notes,
+		                               const uint32_t *chordOffsets, size_t chordCount, int32_t semitones,
+		                               const Spelling &spelling, PackedNote *transposed, char *names,
+		                               size_t nameStride, int32_t *rankings = nullptr);
+	};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ChordNamer {
+	/*
+	Equal division of the octave in N steps (N-EDO / N-TET).
+	Pitch-class sets are bit masks of N bits, stored in the narrowest unsigned type
+	that fits (uint16_t for 12-TET, uint32_t for 19/24/31-TET, uint64_t up to 64).
+
+	steps maps each 12-TET semitone interval (the index used by the interval macros
+	of interval.h) to the nearest step of the tuning, so for 12-TET it is the identity.
+	*/
+	template<uint32_t N>
+	struct Tuning {
+		static_assert(N >= 12 && N <= 64, "Tunings from 12 to 64 steps are supported");
+
+		using Mask = std::conditional_t<(N <= 16), uint16_t, std::conditional_t<(N <= 32), uint32_t, uint64_t> >;
+
+		static constexpr uint32_t STEPS = N;
+		static constexpr Mask FULL = static_cast<Mask>(N == 64 ? ~uint64_t(0) : (uint64_t(1) << N) - 1);
+
+		static constexpr std::array<uint32_t, 12> steps = [] {
+			std::array<uint32_t, 12> nearest{};
+			for (uint32_t semitone = 0; semitone < 12; semitone++) {
+				nearest[semitone] = (2 * semitone * N + 12) / 24; //round(semitone * N / 12)
+			}
+			return nearest;
+		}();
+
+		/* bit of the step nearest to a 12-TET semitone interval */
+		static constexpr Mask bit(const uint32_t semitone) {
+			return static_cast<Mask>(Mask(1) << steps[semitone]);
+		}
+
+		/* distances from the step root: rotate the mask so that root becomes bit 0 */
+		static constexpr Mask rotate(const Mask mask, const uint32_t root) {
+			if (root == 0) {
+				return mask;
+			}
+			return static_cast<Mask>(((mask >> root) | (mask << (N - root))) & FULL);
+		}
+	};
+
+	/*
+	Chord quality evaluation on a mask of distances from the root (bit k == k steps
+	above the root), generic over the tuning. Steps that are not the nearest step of
+	any 12-TET interval are named by their step count, e.g. "[7]".
+	Never allocates nor throws.
+	*/
+	template<uint32_t N>
+	class QualityEvaluator {
+	public:
+		using TuningType = Tuning<N>;
+		using Mask = typename TuningType::Mask;
+
+		//12-TET qualities are at most 28 chars, other tunings may list every microtonal step
+		static constexpr uint32_t MAX_QUALITY_LENGTH = (N == 12) ? 31 : 8 * N;
+
+		/*
+		returns the length of the quality, or -1 if it does not fit in capacity
+		ranking: number of additional intervals, + 1 if sus; suspended: sus2 or sus4
+		*/
+		static int32_t evaluate(Mask mask, char *buffer, size_t capacity, int32_t *ranking = nullptr,
+		                        bool *suspended = nullptr) noexcept;
+
+		/* name of every step, see Interval::getIntervalList */
+		static void getIntervalNames(Mask mask, const char *names[N], bool chordMode = false) noexcept;
+	};
+
+	extern template class QualityEvaluator<12>;
+	extern template class QualityEvaluator<19>;
+	extern template class QualityEvaluator<24>;
+	extern template class QualityEvaluator<31>;
+}
@@ -12,6 +12,16 @@ ChordNamer::Chord::Chord(const std::string &line) : Interval(line) {
 	evaluateAllPossibleChordNames();
 }
 
+ChordNamer::Chord::Chord(const std::span<const uint8_t> midiNotes, const Spelling &spelling)
+	: Interval(midiNotes, spelling) {
+	evaluateAllPossibleChordNames();
+}
+
+ChordNamer::Chord::Chord(const uint32_t pitchClassMask, const uint32_t bass, const Spelling &spelling)
+	: Interval(pitchClassMask, bass, spelling) {
+	evaluateAllPossibleChordNames();
+}
+
 ChordNamer::Chord &ChordNamer::Chord::reset(const std::vector<std::string> &allNotes) {
 	Interval::reset(allNotes);
 	chordNames.clear();
@@ -33,6 +43,21 @@ ChordNamer::Chord &ChordNamer::Chord::reset(const std::vector<Note> &allNotes) {
 	return *this;
 }
 
+ChordNamer::Chord &ChordNamer::Chord::reset(const std::span<const uint8_t> midiNotes, const Spelling &spelling) {
+	Interval::reset(midiNotes, spelling);
+	chordNames.clear();
+	evaluateAllPossibleChordNames();
+	return *this;
+}
+
+ChordNamer::Chord &ChordNamer::Chord::reset(const uint32_t pitchClassMask, const uint32_t bass,
+                                            const Spelling &spelling) {
+	Interval::reset(pitchClassMask, bass, spelling);
+	chordNames.clear();
+	evaluateAllPossibleChordNames();
+	return *this;
+}
+
 std::string ChordNamer::Chord::getChordQualityFromNotes(const std::vector<Note> &allNotes, const uint32_t currentRoot,
                                                         int32_t *ranking) {
 	const size_t totalCount = allNotes.size();
@@ -50,104 +75,22 @@ std::string ChordNamer::Chord::getChordQualityFromNotes(const std::vector<Note>
 }
 
 std::string ChordNamer::Chord::getChordQualityFromDists(const std::vector<uint32_t> &distances, int32_t *ranking) {
-	uint32_t extStack[4] = {M7, M9, P11, M13}; //default 7 9 11 13
-
-	std::vector<std::string> intervalList = getIntervalList(distances, true);
-
-	std::vector<std::string> additional;
-
-	std::string quality;
-	std::string sus;
-
-	bool isdim = false;
-
-	bool exist[12] = {false};
+	uint32_t mask = 0;
 	for (uint32_t dist: distances) {
-		exist[dist] = true;
-	}
-
-	if (check(exist[M3])) {
-		//major chord
-		if (!isAltered(exist) && check(exist[A5])) {
-			//augmented chord
-			quality += "aug";
-		}
-		exist[P5] = false;
-	} else if (check(exist[m3])) {
-		//minor chord
-
-		if (!check(exist[P5]) && check(exist[d5])) {
-			//dim chord
-			isdim = true;
-
-			if (exist[m7]) {
-				//mXb5 (halfdim)
-				quality += "m";
-				additional.emplace_back("b5");
-			} else {
-				quality += "dim"; //dim
-			}
-		} else {
-			quality += "m"; //normal minor chord
-		}
-	} else {
-		//suspended chord
-		if (check(exist[P4])) {
-			sus += "sus4";
-		} else if (check(exist[M2])) {
-			sus += "sus2";
-		} else if (check(exist[P5])) {
-			quality += "5";
-		} else {
-			additional.emplace_back("omit3");
-		}
-		exist[P5] = false;
-	}
-
-	std::string extension = getExtensions(exist, extStack, intervalList, isdim);
-	if (extension.empty()) {
-		//check 6 chords
-		if (check(exist[M6])) {
-			quality += "6";
-			if (check(exist[M9])) {
-				//check 6/9 chord
-				quality += "/9";
-			}
-		}
-	}
-
-	quality += extension;
-	quality += sus;
-
-	//dump all the rest of the notes not checked (leftover) to additional
-	for (int32_t i = 1; i < 12; i++) {
-		if (check(exist[i])) {
-			additional.push_back(intervalList[i]);
-		}
+		mask |= 1u << dist;
 	}
 
-	if (additional.size() == 1) {
-		if (additional[0].substr(0, 4) == "omit")
-			quality += "(" + additional[0] + ")";
-		else if (additional[0][0] == '#' || additional[0][0] == 'b')
-			quality += additional[0];
-		else
-			quality += "add" + additional[0];
-	} else if (additional.size() > 1) {
-		quality += "(" + additional[0];
-		for (size_t i = 1; i < additional.size(); i++) {
-			quality += ", " + additional[i];
-		}
-		quality += ")";
-	}
-
-	if (ranking != nullptr) {
-		//the lower the number, the simple the chord name is
-		*ranking = static_cast<int32_t>(additional.size()) + !sus.empty(); //sus has weight 1
-	}
+	char quality[MAX_QUALITY_LENGTH + 1];
+	getChordQualityFromMask(mask, quality, sizeof(quality), ranking);
 	return quality;
 }
 
+int32_t ChordNamer::Chord::getChordQualityFromMask(const uint32_t mask, char *buffer, const size_t capacity,
+                                                   int32_t *ranking, bool *suspended) noexcept {
+	return QualityEvaluator<12>::evaluate(static_cast<uint16_t>(mask & 0xFFF), buffer, capacity, ranking,
+	                                      suspended);
+}
+
 void ChordNamer::Chord::evaluateAllPossibleChordNames() {
 	std::vector<int32_t> ranking;
 	ranking.reserve(uniqueIndexes.size());
@@ -231,45 +174,3 @@ void ChordNamer::Chord::insertionSortChordNames(std::vector<int32_t> &ranking) {
 		}
 	}
 }
-
-std::string ChordNamer::Chord::getExtensions(bool *exist, uint32_t extStack[],
-                                             const std::vector<std::string> &intervalList,
-                                             const bool isdim) {
-	std::string ext;
-	if (check(exist[M7])) {
-		//maj7
-		ext = "maj";
-	} else if (check(exist[m7])) {
-		//dom7
-		//nothing
-	} else if (isdim && check(exist[d7])) {
-		//dim7
-		extStack[0] = d7; //dim7 == maj6
-		extStack[3] = m6; //change 13 to b13
-	} else {
-		return "";
-	}
-
-	uint32_t highest = extStack[0];
-	for (int32_t i = 1; i < 4; i++) {
-		uint32_t currExt = extStack[i];
-		if (check(exist[currExt])) {
-			highest = currExt;
-		}
-	}
-
-	return ext + intervalList[highest];
-}
-
-bool ChordNamer::Chord::isAltered(const bool *exist) {
-	if (exist[M3] && exist[A5] && !(exist[m2] || exist[A2] || exist[d5])) {
-		return false; //only #5 is present, so is aug chord
-	}
-	return (exist[m2] || exist[A2] || exist[d5] || exist[A5]);
-}
-
-bool ChordNamer::Chord::check(bool &val) {
-	bool ret = val;
-	val = false;
-	return ret;
-}
@@ -0,0 +1,80 @@
+#include <new>
+#include <exception>
+
+#include "chordnamer_c.h"
+#include "naming_engine.h"
+
+//the C constants mirror the C++ ones, the functions below convert between them freely
+static_assert(CHORDNAMER_NAME_CAPACITY == ChordNamer::NamingEngine::MAX_NAME_LENGTH);
+static_assert(CHORDNAMER_MAX_NAMES == ChordNamer::NamingEngine::MAX_CANDIDATES);
+static_assert(static_cast<int32_t>(CHORDNAMER_OK) == ChordNamer::NamingEngine::OK);
+static_assert(static_cast<int32_t>(CHORDNAMER_ERROR_INVALID_ARGUMENT) == ChordNamer::NamingEngine::INVALID_ARGUMENT);
+static_assert(static_cast<int32_t>(CHORDNAMER_ERROR_INVALID_NOTE) == ChordNamer::NamingEngine::INVALID_NOTE);
+static_assert(static_cast<int32_t>(CHORDNAMER_ERROR_BUFFER_TOO_SMALL) == ChordNamer::NamingEngine::BUFFER_TOO_SMALL);
+static_assert(CHORDNAMER_PACK_NOTE(0, 0) == ChordNamer::Note::pack(0, ChordNamer::Note::NATURAL));
+static_assert(CHORDNAMER_PACK_NOTE(1, 1) == ChordNamer::Note::pack(1, ChordNamer::Note::SHARP));
+static_assert(CHORDNAMER_PACK_NOTE(1, -1) == ChordNamer::Note::pack(1, ChordNamer::Note::FLAT));
+static_assert(CHORDNAMER_PACK_NOTE(11, -2) == ChordNamer::Note::pack(11, ChordNamer::Note::DOUBLE_FLAT));
+static_assert(CHORDNAMER_PACK_NOTE(10, 2) == ChordNamer::Note::pack(10, ChordNamer::Note::DOUBLE_SHARP));
+
+struct chordnamer_engine {
+	ChordNamer::NamingEngine engine;
+};
+
+uint32_t chordnamer_abi_version(void) noexcept {
+	return CHORDNAMER_ABI_VERSION;
+}
+
+chordnamer_engine *chordnamer_engine_create(void) noexcept {
+	try {
+		return new chordnamer_engine;
+	} catch (const std::exception &) {
+		return nullptr;
+	}
+}
+
+void chordnamer_engine_destroy(chordnamer_engine *engine) noexcept {
+	delete engine;
+}
+
+chordnamer_status chordnamer_name_chord(const chordnamer_engine *engine, const chordnamer_note *notes,
+                                        const uint32_t noteCount, char *names, const size_t nameStride,
+                                        const uint32_t maxNames, int32_t *rankings,
+                                        uint32_t *nameCount) noexcept {
+	if (engine == nullptr || (names == nullptr && maxNames > 0)) {
+		return CHORDNAMER_ERROR_INVALID_ARGUMENT;
+	}
+
+	ChordNamer::NamingEngine::Candidate candidates[ChordNamer::NamingEngine::MAX_CANDIDATES];
+	const int32_t count = engine->engine.evaluate(notes, noteCount, candidates);
+	if (count < 0) {
+		return static_cast<chordnamer_status>(count);
+	}
+
+	const uint32_t written = (static_cast<uint32_t>(count) < maxNames) ? count : maxNames;
+	for (uint32_t i = 0; i < written; i++) {
+		const int32_t status = engine->engine.format(notes, candidates[i], names + i * nameStride, nameStride);
+		if (status < 0) {
+			return static_cast<chordnamer_status>(status);
+		}
+		if (rankings != nullptr) {
+			rankings[i] = candidates[i].ranking;
+		}
+	}
+
+	if (nameCount != nullptr) {
+		*nameCount = written;
+	}
+	return CHORDNAMER_OK;
+}
+
+int64_t chordnamer_name_batch(const chordnamer_engine *engine, const chordnamer_note *notes,
+                              const uint32_t *chordOffsets, const size_t chordCount, char *names,
+                              const size_t nameStride, int32_t *rankings, int32_t *statuses) noexcept {
+	if (engine == nullptr || notes == nullptr || chordOffsets == nullptr || names == nullptr || nameStride == 0) {
+		return CHORDNAMER_ERROR_INVALID_ARGUMENT;
+	}
+
+	return static_cast<int64_t>(engine->engine.nameBatch(notes, chordOffsets, chordCount, names, nameStride,
+	                                                     rankings, statuses));
+}
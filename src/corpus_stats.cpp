@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <thread>
+
+#include "corpus_stats.h"
+
+ChordNamer::HeavyHitters::HeavyHitters(const size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {
+	//add replaces the smallest counter when full, so there has to be one
+	counters.reserve(this->capacity);
+	index.reserve(this->capacity);
+}
+
+void ChordNamer::HeavyHitters::add(const uint32_t key, const uint64_t count) {
+	if (auto it = index.find(key); it != index.end()) {
+		counters[it->second].count += count;
+		return;
+	}
+
+	if (counters.size() < capacity) {
+		index.emplace(key, counters.size());
+		counters.push_back({key, count, 0});
+		return;
+	}
+
+	//replace the smallest counter, the new key inherits its count as error
+	const auto smallest = std::min_element(counters.begin(), counters.end(), [](const Counter &a, const Counter &b) {
+		return a.count < b.count;
+	});
+	index.erase(smallest->key);
+	index.emplace(key, smallest - counters.begin());
+	*smallest = {key, smallest->count + count, smallest->count};
+}
+
+void ChordNamer::HeavyHitters::merge(const HeavyHitters &other) {
+	//a key missing from a full sketch may have been counted up to its smallest count
+	const uint64_t ownMissing = (counters.size() < capacity) ? 0 : minCount();
+	const uint64_t otherMissing = (other.counters.size() < other.capacity) ? 0 : other.minCount();
+
+	std::vector<Counter> merged;
+	merged.reserve(counters.size() + other.counters.size());
+
+	for (const Counter &counter: counters) {
+		Counter sum = counter;
+		if (auto it = other.index.find(counter.key); it != other.index.end()) {
+			sum.count += other.counters[it->second].count;
+			sum.error += other.counters[it->second].error;
+		} else {
+			sum.count += otherMissing;
+			sum.error += otherMissing;
+		}
+		merged.push_back(sum);
+	}
+	for (const Counter &counter: other.counters) {
+		if (index.find(counter.key) == index.end()) {
+			merged.push_back({counter.key, counter.count + ownMissing, counter.error + ownMissing});
+		}
+	}
+
+	if (merged.size() > capacity) {
+		std::nth_element(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(capacity), merged.end(),
+		                 [](const Counter &a, const Counter &b) {
+			                 return a.count > b.count;
+		                 });
+		merged.resize(capacity);
+	}
+
+	counters = std::move(merged);
+	index.clear();
+	for (size_t i = 0; i < counters.size(); i++) {
+		index.emplace(counters[i].key, i);
+	}
+}
+
+std::vector<ChordNamer::HeavyHitters::Counter> ChordNamer::HeavyHitters::top(const size_t k) const {
+	std::vector<Counter> sorted = counters;
+	std::sort(sorted.begin(), sorted.end(), [](const Counter &a, const Counter &b) {
+		return a.count > b.count || (a.count == b.count && a.key < b.key);
+	});
+	if (sorted.size() > k) {
+		sorted.resize(k);
+	}
+	return sorted;
+}
+
+uint64_t ChordNamer::HeavyHitters::minCount() const {
+	uint64_t smallest = UINT64_MAX;
+	for (const Counter &counter: counters) {
+		smallest = std::min(smallest, counter.count);
+	}
+	return counters.empty() ? 0 : smallest;
+}
+
+ChordNamer::CorpusSummary::CorpusSummary() : qualityCounts(QualityTable::MASK_COUNT) {
+}
+
+void ChordNamer::CorpusSummary::add(const PackedNote *notes, const NamingEngine::Candidate &best,
+                                    const uint32_t *previousKey) {
+	const uint32_t key = nameKey(notes, best);
+
+	chords++;
+	qualityCounts[best.mask]++;
+	rankingCounts[std::min<uint32_t>(best.ranking, MAX_RANKING)]++;
+
+	if (best.root != 0) {
+		const uint32_t bassDistance = ((notes[0] & 0x0F) - (notes[best.root] & 0x0F) + 12) % 12;
+		if (best.mask & (1u << bassDistance)) {
+			inversions++;
+		} else {
+			slashChords++;
+		}
+	}
+
+	topNames.add(key);
+	if (previousKey != nullptr) {
+		bigrams[(static_cast<uint64_t>(*previousKey) << 32) | key]++;
+	}
+}
+
+void ChordNamer::CorpusSummary::merge(const CorpusSummary &other) {
+	chords += other.chords;
+	failures += other.failures;
+	inversions += other.inversions;
+	slashChords += other.slashChords;
+
+	for (size_t i = 0; i < qualityCounts.size(); i++) {
+		qualityCounts[i] += other.qualityCounts[i];
+	}
+	for (size_t i = 0; i < rankingCounts.size(); i++) {
+		rankingCounts[i] += other.rankingCounts[i];
+	}
+
+	topNames.merge(other.topNames);
+
+	for (const auto &[bigram, count]: other.bigrams) {
+		bigrams[bigram] += count;
+	}
+}
+
+uint32_t ChordNamer::CorpusSummary::nameKey(const PackedNote *notes, const NamingEngine::Candidate &best) {
+	uint32_t key = best.mask | (static_cast<uint32_t>(notes[best.root]) << 12);
+	if (best.root != 0) {
+		key |= (static_cast<uint32_t>(notes[0]) << 20) | (1u << 28);
+	}
+	return key;
+}
+
+std::string ChordNamer::CorpusSummary::keyToName(const NamingEngine &engine, const uint32_t key) {
+	std::string name = Note::unpack(static_cast<PackedNote>((key >> 12) & 0xFF)).toCString();
+	name += engine.getQualityTable().quality(key & 0xFFF);
+	if (key & (1u << 28)) {
+		name += '/';
+		name += Note::unpack(static_cast<PackedNote>((key >> 20) & 0xFF)).toCString();
+	}
+	return name;
+}
+
+ChordNamer::CorpusSummary ChordNamer::CorpusStats::analyze(const NamingEngine &engine, const PackedNote *notes,
+                                                           const uint32_t *chordOffsets, const size_t chordCount,
+                                                           const uint8_t *pieceStarts, uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	threadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, std::max<size_t>(chordCount, 1)));
+
+	//one summary per thread, no shared state until the final reduction
+	std::vector<CorpusSummary> summaries(threadCount);
+	std::vector<std::thread> threads;
+
+	const size_t chunk = (chordCount + threadCount - 1) / threadCount;
+	for (uint32_t t = 1; t < threadCount; t++) {
+		const size_t begin = std::min(chordCount, t * chunk);
+		const size_t end = std::min(chordCount, begin + chunk);
+		threads.emplace_back(analyzeRange, std::cref(engine), notes, chordOffsets, pieceStarts, begin, end,
+		                     std::ref(summaries[t]));
+	}
+	analyzeRange(engine, notes, chordOffsets, pieceStarts, 0, std::min(chordCount, chunk), summaries[0]);
+
+	for (std::thread &thread: threads) {
+		thread.join();
+	}
+	for (uint32_t t = 1; t < threadCount; t++) {
+		summaries[0].merge(summaries[t]);
+	}
+	return std::move(summaries[0]);
+}
+
+void ChordNamer::CorpusStats::analyzeRange(const NamingEngine &engine, const PackedNote *notes,
+                                           const uint32_t *chordOffsets, const uint8_t *pieceStarts,
+                                           const size_t begin, const size_t end, CorpusSummary &summary) {
+	NamingEngine::Candidate candidates[NamingEngine::MAX_CANDIDATES];
+
+	//like the daemon and Interval, a single note is not a chord
+	auto evaluate = [&](const size_t i) {
+		const uint32_t count = chordOffsets[i + 1] - chordOffsets[i];
+		return count >= 2 && engine.evaluate(notes + chordOffsets[i], count, candidates) > 0;
+	};
+
+	//the chord before the range, so that bigrams spanning two ranges are not lost
+	uint32_t previousKey = 0;
+	bool hasPrevious = begin > 0 && begin < end && !(pieceStarts != nullptr && pieceStarts[begin])
+	                   && evaluate(begin - 1);
+	if (hasPrevious) {
+		previousKey = CorpusSummary::nameKey(notes + chordOffsets[begin - 1], candidates[0]);
+	}
+
+	for (size_t i = begin; i < end; i++) {
+		if (pieceStarts != nullptr && pieceStarts[i]) {
+			hasPrevious = false;
+		}
+		if (!evaluate(i)) {
+			summary.addFailure();
+			hasPrevious = false;
+			continue;
+		}
+
+		const PackedNote *chord = notes + chordOffsets[i];
+		summary.add(chord, candidates[0], hasPrevious ? &previousKey : nullptr);
+		previousKey = CorpusSummary::nameKey(chord, candidates[0]);
+		hasPrevious = true;
+	}
+}
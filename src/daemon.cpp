@@ -0,0 +1,368 @@
+/*
+Local chord naming daemon.
+
+Listens on a Unix domain socket and answers newline-terminated requests, one per
+line, in the same format as the demo ("C E G" or "C,E,G"). Each response is a line
+holding the simplest chord name and its ranking separated by a tab, or a line
+starting with "error:". Clients may pipeline any number of requests; responses
+come back in order.
+
+Every wake-up of the epoll loop drains all readable connections first, then names
+every complete request of every connection with a single NamingEngine::nameBatch call.
+
+usage: chordnamer_Daemon [socket path]
+*/
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "naming_engine.h"
+#include "note.h"
+
+using namespace ChordNamer;
+
+namespace {
+	constexpr size_t MAX_LINE_LENGTH = 4096;
+	constexpr int MAX_EVENTS = 256;
+	constexpr size_t READ_CHUNK = 64 * 1024;
+	constexpr size_t MAX_BACKLOG = 1024 * 1024; //unanswered input or unsent output above which reading stops
+
+	volatile std::sig_atomic_t running = 1;
+
+	struct Connection {
+		explicit Connection(const int fd) : fd(fd) {
+		}
+
+		int fd;
+		std::string in;
+		std::string out;
+		size_t outOffset = 0;
+		uint32_t interest = EPOLLIN; //events registered with epoll
+		bool closing = false;
+	};
+
+	struct Request {
+		Connection *connection;
+		int32_t status; //parse status, OK if the notes went to the batch
+		uint32_t batchIndex;
+	};
+
+	void stop(int) {
+		running = 0;
+	}
+
+	class Daemon {
+	public:
+		explicit Daemon(const char *path) : path(path) {
+		}
+
+		~Daemon() {
+			for (auto &[fd, connection]: connections) {
+				close(fd);
+			}
+			if (listenFd != -1) {
+				close(listenFd);
+				unlink(path);
+			}
+			if (epollFd != -1) {
+				close(epollFd);
+			}
+		}
+
+		bool start() {
+			listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+			if (listenFd == -1) {
+				perror("socket");
+				return false;
+			}
+
+			sockaddr_un address{};
+			address.sun_family = AF_UNIX;
+			if (std::strlen(path) >= sizeof(address.sun_path)) {
+				fprintf(stderr, "Socket path too long: %s\n", path);
+				return false;
+			}
+			std::strcpy(address.sun_path, path);
+			unlink(path);
+
+			if (bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1) {
+				perror("bind");
+				return false;
+			}
+			if (listen(listenFd, SOMAXCONN) == -1) {
+				perror("listen");
+				return false;
+			}
+
+			epollFd = epoll_create1(EPOLL_CLOEXEC);
+			if (epollFd == -1) {
+				perror("epoll_create1");
+				return false;
+			}
+
+			epoll_event event{};
+			event.events = EPOLLIN;
+			event.data.fd = listenFd;
+			return epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) != -1;
+		}
+
+		void run() {
+			epoll_event events[MAX_EVENTS];
+
+			while (running) {
+				const int count = epoll_wait(epollFd, events, MAX_EVENTS, 500);
+				if (count == -1) {
+					if (errno == EINTR) {
+						continue;
+					}
+					perror("epoll_wait");
+					return;
+				}
+
+				for (int i = 0; i < count; i++) {
+					const int fd = events[i].data.fd;
+					if (fd == listenFd) {
+						acceptAll();
+						continue;
+					}
+
+					auto it = connections.find(fd);
+					if (it == connections.end()) {
+						continue;
+					}
+					Connection &connection = it->second;
+
+					if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && readable(connection)) {
+						readAll(connection);
+					}
+					if (events[i].events & EPOLLOUT) {
+						flush(connection);
+					}
+				}
+
+				processPending();
+
+				//flush every connection that got new responses and drop the closed ones
+				for (auto it = connections.begin(); it != connections.end();) {
+					Connection &connection = it->second;
+					flush(connection);
+					if (connection.closing && connection.outOffset == connection.out.size()) {
+						close(connection.fd);
+						it = connections.erase(it);
+					} else {
+						updateInterest(connection);
+						++it;
+					}
+				}
+			}
+		}
+
+	private:
+		void acceptAll() {
+			while (true) {
+				const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+				if (fd == -1) {
+					if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+						perror("accept4");
+					}
+					return;
+				}
+
+				epoll_event event{};
+				event.events = EPOLLIN;
+				event.data.fd = fd;
+				if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+					close(fd);
+					continue;
+				}
+				connections.emplace(fd, Connection{fd});
+			}
+		}
+
+		/* neither closing nor too far behind on its responses */
+		static bool readable(const Connection &connection) {
+			return !connection.closing && connection.out.size() - connection.outOffset < MAX_BACKLOG;
+		}
+
+		/* stops at MAX_BACKLOG, the rest stays in the socket until the next wake-up */
+		void readAll(Connection &connection) {
+			char buffer[READ_CHUNK];
+			while (connection.in.size() < MAX_BACKLOG) {
+				const ssize_t n = read(connection.fd, buffer, sizeof(buffer));
+				if (n > 0) {
+					connection.in.append(buffer, n);
+					continue;
+				}
+				if (n == -1 && errno == EINTR) {
+					continue;
+				}
+				if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+					//peer closed: answer what was already received, then close
+					connection.closing = true;
+				}
+				return;
+			}
+		}
+
+		/* gather the complete lines of every connection and name them in one batch */
+		void processPending() {
+			requests.clear();
+			notes.clear();
+			offsets.assign(1, 0);
+
+			for (auto &[fd, connection]: connections) {
+				size_t start = 0;
+				size_t end;
+				while ((end = connection.in.find('\n', start)) != std::string::npos) {
+					const std::string_view line(connection.in.data() + start, end - start);
+					start = end + 1;
+
+					const size_t before = notes.size();
+					if (!Note::parseList(line, notes)) {
+						requests.push_back({&connection, NamingEngine::INVALID_NOTE, 0});
+					} else if (notes.size() - before < 2) {
+						notes.resize(before);
+						requests.push_back({&connection, NamingEngine::INVALID_ARGUMENT, 0});
+					} else {
+						requests.push_back({&connection, NamingEngine::OK, static_cast<uint32_t>(offsets.size() - 1)});
+						offsets.push_back(static_cast<uint32_t>(notes.size()));
+					}
+				}
+				connection.in.erase(0, start);
+
+				if (connection.in.size() > MAX_LINE_LENGTH) {
+					connection.in.clear();
+					connection.out += "error: request too long\n";
+					connection.closing = true;
+				}
+			}
+
+			const size_t chordCount = offsets.size() - 1;
+			names.resize(chordCount * NamingEngine::MAX_NAME_LENGTH);
+			rankings.resize(chordCount);
+			statuses.resize(chordCount);
+
+			if (chordCount > 0) {
+				engine.nameBatch(notes.data(), offsets.data(), chordCount, names.data(), NamingEngine::MAX_NAME_LENGTH,
+				                 rankings.data(), statuses.data());
+			}
+
+			//requests are in arrival order per connection, so responses stay in order
+			for (const Request &request: requests) {
+				std::string &out = request.connection->out;
+				int32_t status = request.status;
+				if (status == NamingEngine::OK) {
+					status = statuses[request.batchIndex];
+				}
+
+				switch (status) {
+					case NamingEngine::OK:
+						out += &names[request.batchIndex * NamingEngine::MAX_NAME_LENGTH];
+						out += '\t';
+						out += std::to_string(rankings[request.batchIndex]);
+						out += '\n';
+						break;
+					case NamingEngine::INVALID_NOTE:
+						out += "error: invalid note\n";
+						break;
+					case NamingEngine::INVALID_ARGUMENT:
+						out += "error: at least two notes are required\n";
+						break;
+					default:
+						out += "error: naming failed\n";
+						break;
+				}
+			}
+		}
+
+		void flush(Connection &connection) {
+			while (connection.outOffset < connection.out.size()) {
+				const ssize_t n = write(connection.fd, connection.out.data() + connection.outOffset,
+				                        connection.out.size() - connection.outOffset);
+				if (n > 0) {
+					connection.outOffset += n;
+					continue;
+				}
+				if (n == -1 && errno == EINTR) {
+					continue;
+				}
+				if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+					//keep only the unsent part, so that a slow reader does not make out grow
+					connection.out.erase(0, connection.outOffset);
+					connection.outOffset = 0;
+					return;
+				}
+				//broken connection, drop pending output
+				connection.out.clear();
+				connection.outOffset = 0;
+				connection.closing = true;
+				return;
+			}
+
+			connection.out.clear();
+			connection.outOffset = 0;
+		}
+
+		/*
+		EPOLLIN only while the connection is readable, so that a closing or backlogged
+		connection does not wake the loop up again and again; EPOLLOUT while output is pending
+		*/
+		void updateInterest(Connection &connection) {
+			const uint32_t interest = (readable(connection) ? static_cast<uint32_t>(EPOLLIN) : 0u)
+			                          | (connection.outOffset < connection.out.size() ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+			if (connection.interest == interest) {
+				return;
+			}
+			epoll_event event{};
+			event.events = interest;
+			event.data.fd = connection.fd;
+			epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+			connection.interest = interest;
+		}
+
+		const char *path;
+		int listenFd = -1;
+		int epollFd = -1;
+
+		NamingEngine engine;
+		std::unordered_map<int, Connection> connections;
+
+		//batch buffers, reused across iterations so the steady state does not allocate
+		std::vector<Request> requests;
+		std::vector<PackedNote> notes;
+		std::vector<uint32_t> offsets;
+		std::vector<char> names;
+		std::vector<int32_t> rankings;
+		std::vector<int32_t> statuses;
+	};
+}
+
+int main(int argc, char *argv[]) {
+	const char *path = (argc > 1) ? argv[1] : "/tmp/chordnamer.sock";
+
+	std::signal(SIGPIPE, SIG_IGN);
+	std::signal(SIGINT, stop);
+	std::signal(SIGTERM, stop);
+
+	Daemon daemon(path);
+	if (!daemon.start()) {
+		return 1;
+	}
+
+	printf("Listening on %s\n", path);
+	fflush(stdout);
+	daemon.run();
+
+	return 0;
+}
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <stdexcept>
 
 #include "interval.h"
+#include "tuning.h"
 
 ChordNamer::Interval::Interval(const std::string &line) {
     reset(line);
@@ -11,91 +13,114 @@ ChordNamer::Interval::Interval(const std::vector<std::string> &allNotes) {
 }
 
 ChordNamer::Interval::Interval(const std::vector<Note> &allNotes) : allNotes(allNotes) {
-    uniqueIndexes = Note::getUniqueIndexes(allNotes);
+    updateUniqueIndexes();
+}
+
+ChordNamer::Interval::Interval(const std::span<const uint8_t> midiNotes, const Spelling &spelling) {
+    reset(midiNotes, spelling);
+}
+
+ChordNamer::Interval::Interval(const uint32_t pitchClassMask, const uint32_t bass, const Spelling &spelling) {
+    reset(pitchClassMask, bass, spelling);
 }
 
 ChordNamer::Interval &ChordNamer::Interval::reset(const std::string &line) {
+    midiNotes.clear();
     split(line);
     if (allNotes.size() < 2) {
         throw std::length_error("At least two notes are required.");
     }
-    uniqueIndexes = Note::getUniqueIndexes(allNotes);
+    updateUniqueIndexes();
     return *this;
 }
 
 ChordNamer::Interval &ChordNamer::Interval::reset(const std::vector<std::string> &allNotes) {
+    midiNotes.clear();
     this->allNotes.clear();
     //convert strings to notes
     for (const std::string &noteStr: allNotes) {
         this->allNotes.emplace_back(noteStr);
     }
-    uniqueIndexes = Note::getUniqueIndexes(this->allNotes);
+    updateUniqueIndexes();
     return *this;
 }
 
 ChordNamer::Interval &ChordNamer::Interval::reset(const std::vector<Note> &allNotes) {
+    midiNotes.clear();
     this->allNotes = allNotes;
-    uniqueIndexes = Note::getUniqueIndexes(allNotes);
+    updateUniqueIndexes();
     return *this;
 }
 
-std::vector<std::string>
-ChordNamer::Interval::getIntervalList(const std::vector<uint32_t> &distances, const bool chordMode) {
-    std::vector<std::string> possibleIntervals = {"1", "b9", "9", "b3", "3", "11", "b5", "5", "#5", "6", "b7", "7"};
-
-    bool exist[12] = {false};
-    //below compare with semitone interval
-    //if 3 and b3 is present, b3 becomes #9
-    //if 5 and (b5 || #5) is present, (#11 || b13) is used
-    //if 7 is present, 6 becomes 13
-    //if b3/3 is NOT present, 4 is used instead of 11
-    //if both b3/3 and 4 are NOT present, then 2 is used instead of 9
-    //if b3 and b5 and 6 are present (diminished) , then 6/13 becomes 7 and b6/b13 becomes 13
-
-    bool thirdPresent = false;
-
-    for (uint32_t distance: distances) {
-        exist[distance] = true;
+ChordNamer::Interval &ChordNamer::Interval::reset(const std::span<const uint8_t> midiNotes, const Spelling &spelling) {
+    //validate everything first, so that a bad note leaves the interval untouched
+    for (const uint8_t midi: midiNotes) {
+        if (midi > 127) {
+            throw std::invalid_argument("Invalid MIDI note: " + std::to_string(midi));
+        }
     }
 
-    if (exist[M3]) {
-        //major 3rd
-        possibleIntervals[m3] = "#9";
-        thirdPresent = true;
+    this->midiNotes.assign(midiNotes.begin(), midiNotes.end());
+    std::sort(this->midiNotes.begin(), this->midiNotes.end());
+
+    //reuse the notes of the previous chord, so only their spelling is rewritten
+    const size_t count = this->midiNotes.size();
+    if (allNotes.size() > count) {
+        allNotes.erase(allNotes.begin() + static_cast<std::ptrdiff_t>(count), allNotes.end());
     }
-    if (exist[P5]) {
-        //perfect 5th
-        possibleIntervals[d5] = "#11";
-        possibleIntervals[m6] = "b13";
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t midi = this->midiNotes[i];
+        //MIDI 69 is A4, and A == 0
+        const PackedNote packed = spelling.spell((midi + 3) % 12);
+        if (i < allNotes.size()) {
+            allNotes[i].assign(packed);
+        } else {
+            allNotes.push_back(Note::unpack(packed));
+        }
     }
-    if (exist[m7] || exist[M7]) {
-        //minor or major 7th
-        possibleIntervals[M6] = "13";
+    updateUniqueIndexes();
+    return *this;
+}
+
+ChordNamer::Interval &ChordNamer::Interval::reset(const uint32_t pitchClassMask, const uint32_t bass,
+                                                  const Spelling &spelling) {
+    if (bass >= 12) {
+        throw std::invalid_argument("Invalid bass: " + std::to_string(bass));
     }
-    if (exist[m3]) {
-        //minor 3rd
-        thirdPresent = true;
-        if (exist[d5] && exist[d7] && !exist[m7] && !exist[M7]) {
-            //full diminished chord
-            if (chordMode) {
-                possibleIntervals[d7] = "7";
-                possibleIntervals[m6] = "13";
-            } else {
-                possibleIntervals[d7] = "bb7";
-                possibleIntervals[m6] = "b13";
-            }
+    const uint32_t mask = (pitchClassMask & 0xFFF) | (1u << bass);
+
+    midiNotes.clear();
+    allNotes.clear();
+    uniqueIndexes.clear();
+    for (uint32_t k = 0; k < 12; k++) {
+        const uint32_t absoluteNote = (bass + k) % 12;
+        if (mask & (1u << absoluteNote)) {
+            //stacked upwards from the bass, so every note is unique
+            uniqueIndexes.push_back(allNotes.size());
+            allNotes.push_back(Note::unpack(spelling.spell(absoluteNote)));
         }
     }
+    return *this;
+}
 
-    if (!thirdPresent) {
-        //sus chord
-        possibleIntervals[P4] = "4";
+uint32_t ChordNamer::Interval::getPitchClassMask() const {
+    return Note::getPitchClassMask(allNotes);
+}
 
-        if (!exist[P4])
-            possibleIntervals[M2] = "2";
+std::vector<std::string>
+ChordNamer::Interval::getIntervalList(const std::vector<uint32_t> &distances, const bool chordMode) {
+    uint32_t mask = 0;
+    for (uint32_t distance: distances) {
+        mask |= 1u << distance;
     }
 
-    return possibleIntervals;
+    const char *names[12];
+    getIntervalNames(mask, names, chordMode);
+    return {names, names + 12};
+}
+
+void ChordNamer::Interval::getIntervalNames(const uint32_t mask, const char *names[12], const bool chordMode) noexcept {
+    QualityEvaluator<12>::getIntervalNames(static_cast<uint16_t>(mask & 0xFFF), names, chordMode);
 }
 
 std::vector<std::string> ChordNamer::Interval::distancesToIntervals(const std::vector<uint32_t> &distances) {
@@ -110,6 +135,19 @@ std::vector<std::string> ChordNamer::Interval::distancesToIntervals(const std::v
     return intervals;
 }
 
+void ChordNamer::Interval::updateUniqueIndexes() {
+    //same as Note::getUniqueIndexes, reusing the storage of uniqueIndexes
+    uint32_t seen = 0;
+    uniqueIndexes.clear();
+    for (size_t i = 0; i < allNotes.size(); i++) {
+        const uint32_t bit = 1u << allNotes[i].getDistanceTo(allNotes[0]);
+        if (!(seen & bit)) {
+            seen |= bit;
+            uniqueIndexes.push_back(i);
+        }
+    }
+}
+
 void ChordNamer::Interval::split(const std::string &line) {
     this->allNotes.clear();
     std::string noteStr;
@@ -0,0 +1,156 @@
+/*
+Load generator for chordnamer_Daemon.
+
+Opens several connections, each pipelining requests in windows of a fixed depth,
+and reports the throughput and the mean round trip of a window.
+
+usage: chordnamer_LoadGen [socket path] [connections] [requests per connection] [pipeline depth]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+	const char *sampleChords[] = {
+		"C E G", "A C E G", "D F# A C", "G B D F A", "E G# B D F", "Bb D F Ab C",
+		"C Eb Gb A", "F A C E G B", "E G Bb D", "Db F Ab Cb Eb", "C D G", "F# A# C# E G#",
+	};
+
+	struct Result {
+		size_t responses = 0;
+		size_t errors = 0;
+		double windowSeconds = 0;
+		size_t windows = 0;
+	};
+
+	int connectTo(const char *path) {
+		const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd == -1) {
+			return -1;
+		}
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+		if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1) {
+			close(fd);
+			return -1;
+		}
+		return fd;
+	}
+
+	bool writeAll(const int fd, const std::string &data) {
+		size_t offset = 0;
+		while (offset < data.size()) {
+			const ssize_t n = write(fd, data.data() + offset, data.size() - offset);
+			if (n <= 0) {
+				return false;
+			}
+			offset += n;
+		}
+		return true;
+	}
+
+	void runConnection(const char *path, const size_t requestCount, const size_t depth, Result &result) {
+		const int fd = connectTo(path);
+		if (fd == -1) {
+			perror("connect");
+			return;
+		}
+
+		const size_t sampleCount = sizeof(sampleChords) / sizeof(sampleChords[0]);
+		std::string window;
+		char buffer[64 * 1024];
+		size_t sent = 0;
+
+		while (sent < requestCount) {
+			const size_t batch = std::min(depth, requestCount - sent);
+			window.clear();
+			for (size_t i = 0; i < batch; i++) {
+				window += sampleChords[(sent + i) % sampleCount];
+				window += '\n';
+			}
+
+			const auto begin = std::chrono::steady_clock::now();
+			if (!writeAll(fd, window)) {
+				break;
+			}
+
+			size_t pending = batch;
+			bool lineStart = true;
+			while (pending > 0) {
+				const ssize_t n = read(fd, buffer, sizeof(buffer));
+				if (n <= 0) {
+					close(fd);
+					return;
+				}
+				for (ssize_t i = 0; i < n; i++) {
+					if (lineStart && buffer[i] == 'e') {
+						result.errors++;
+					}
+					lineStart = buffer[i] == '\n';
+					if (lineStart) {
+						pending--;
+						result.responses++;
+					}
+				}
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			result.windowSeconds += std::chrono::duration<double>(end - begin).count();
+			result.windows++;
+			sent += batch;
+		}
+
+		close(fd);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	const char *path = (argc > 1) ? argv[1] : "/tmp/chordnamer.sock";
+	const size_t connectionCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 8;
+	const size_t requestCount = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 100000;
+	const size_t depth = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 64;
+
+	if (connectionCount == 0 || depth == 0) {
+		fprintf(stderr, "Connections and pipeline depth must be positive\n");
+		return 1;
+	}
+
+	std::vector<Result> results(connectionCount);
+	std::vector<std::thread> threads;
+
+	const auto begin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < connectionCount; i++) {
+		threads.emplace_back(runConnection, path, requestCount, depth, std::ref(results[i]));
+	}
+	for (std::thread &thread: threads) {
+		thread.join();
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	Result total;
+	for (const Result &result: results) {
+		total.responses += result.responses;
+		total.errors += result.errors;
+		total.windowSeconds += result.windowSeconds;
+		total.windows += result.windows;
+	}
+
+	printf("Connections: %zu, pipeline depth: %zu\n", connectionCount, depth);
+	printf("Responses: %zu (%zu errors) in %.3f s\n", total.responses, total.errors, seconds);
+	printf("Throughput: %.0f requests/s\n", total.responses / seconds);
+	if (total.windows > 0) {
+		printf("Mean window round trip: %.1f us\n", 1e6 * total.windowSeconds / total.windows);
+	}
+
+	return total.responses == connectionCount * requestCount ? 0 : 1;
+}
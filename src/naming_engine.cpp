@@ -0,0 +1,13 @@
+#include "naming_engine.h"
+
+int32_t ChordNamer::NamingEngine::format(const PackedNote *notes, const Candidate &candidate, char *buffer,
+                                         const size_t capacity) const noexcept {
+	if (notes == nullptr || buffer == nullptr) {
+		return INVALID_ARGUMENT;
+	}
+	if (capacity <= candidate.length) {
+		return BUFFER_TOO_SMALL;
+	}
+
+	return detail::writeName(notes, candidate, table.quality(candidate.mask), table.length(candidate.mask), buffer);
+}
@@ -0,0 +1,89 @@
+#include <bit>
+
+#include "naming_pipeline.h"
+
+ChordNamer::NamingPipeline::NamingPipeline(const NamingEngine &engine, const Spelling &spelling) : engine(engine),
+	spelling(spelling) {
+}
+
+ChordNamer::NamingPipeline::~NamingPipeline() {
+	stop();
+}
+
+size_t ChordNamer::NamingPipeline::process() noexcept {
+	NoteEvent event;
+	size_t processed = 0;
+	uint64_t oldest = 0;
+
+	//bounded by the ring capacity, events pushed meanwhile wait for the next call
+	while (processed < EVENT_CAPACITY && events.tryPop(event)) {
+		if (processed == 0) {
+			oldest = event.timestamp;
+		}
+		const uint32_t note = event.note & 0x7F;
+		if (event.velocity != 0) {
+			held[note >> 6] |= 1ull << (note & 63);
+		} else {
+			held[note >> 6] &= ~(1ull << (note & 63));
+		}
+		processed++;
+	}
+	if (processed == 0) {
+		return 0;
+	}
+
+	Result result;
+	result.sequence = ++sequence;
+	result.timestamp = oldest;
+	result.ranking = -1;
+	result.noteCount = 0;
+	result.name[0] = '\0';
+
+	//held notes from the lowest, so that the bass comes first
+	PackedNote notes[128];
+	for (uint32_t word = 0; word < 2; word++) {
+		for (uint64_t rest = held[word]; rest != 0; rest &= rest - 1) {
+			const uint32_t midi = word * 64 + std::countr_zero(rest);
+			notes[result.noteCount++] = spelling.spell((midi + 3) % 12); //MIDI 0 is a C, A == 0
+		}
+	}
+
+	NamingEngine::Candidate candidates[NamingEngine::MAX_CANDIDATES];
+	if (result.noteCount > 0 && engine.evaluate(notes, result.noteCount, candidates) > 0
+	    && engine.format(notes, candidates[0], result.name, sizeof(result.name)) >= 0) {
+		result.ranking = candidates[0].ranking;
+	}
+
+	if (!results.tryPush(result)) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	latestResult.publish(result);
+	return processed;
+}
+
+void ChordNamer::NamingPipeline::start() {
+	if (running.exchange(true)) {
+		return;
+	}
+	worker = std::thread(&NamingPipeline::run, this);
+}
+
+void ChordNamer::NamingPipeline::stop() {
+	running.store(false);
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void ChordNamer::NamingPipeline::run() noexcept {
+	uint32_t idle = 0;
+	while (running.load(std::memory_order_relaxed)) {
+		if (process() != 0) {
+			idle = 0;
+		} else if (++idle > 1000) {
+			//spin first for latency, then give the core away while nothing arrives
+			std::this_thread::yield();
+		}
+	}
+	process(); //events pushed before stop()
+}
@@ -2,21 +2,52 @@
 
 #include "note.h"
 
+namespace {
+    //name of every (absolute note, accidental) pair, empty when the accidental cannot spell the note
+    struct NoteNames {
+        char names[12][5][4] = {};
+
+        constexpr NoteNames() {
+            //the magic happens here
+            constexpr char letters[12] = {'A', '\0', 'B', 'C', '\0', 'D', '\0', 'E', 'F', '\0', 'G', '\0'};
+            constexpr const char *suffixes[5] = {"bb", "b", "", "#", "x"};
+
+            for (int32_t note = 0; note < 12; note++) {
+                for (int32_t accidental = -2; accidental <= 2; accidental++) {
+                    const char letter = letters[(note - accidental + 12) % 12];
+                    if (letter == '\0') {
+                        continue;
+                    }
+                    char *name = names[note][accidental + 2];
+                    name[0] = letter;
+                    for (const char *suffix = suffixes[accidental + 2]; *suffix != '\0'; suffix++) {
+                        *++name = *suffix;
+                    }
+                }
+            }
+        }
+    };
+
+    constexpr NoteNames noteNames;
+}
+
 ChordNamer::Note::Note(const std::string &str, const Accidental preferredAccidental): accidental(NATURAL),
     preferredAccidental(preferredAccidental) {
     if (!validate(str)) {
         throw std::invalid_argument("Invalid note: " + str);
     }
 
+    //the letter comes first, unless the accidental is written before it (LDP-style)
+    const bool prefixed = str.size() >= 2 && (str[0] == '-' || str[0] == '+' || str[0] == 'x');
+    const char c = prefixed ? str.back() : str[0];
+
     int index = -1;
-    for (const char c: str) {
-        if (c >= 'a' && c <= 'g') {
-            // lower case
-            index = c - 97;
-        } else if (c >= 'A' && c <= 'g') {
-            // upper case
-            index = c - 65;
-        }
+    if (c >= 'a' && c <= 'g') {
+        // lower case
+        index = c - 97;
+    } else if (c >= 'A' && c <= 'G') {
+        // upper case
+        index = c - 65;
     }
     if (index == -1) {
         throw std::invalid_argument("Invalid note: " + str);
@@ -64,11 +95,30 @@ ChordNamer::Note::Note(const std::string &str, const Accidental preferredAcciden
                 }
                 break;
         }
-    } else {
-        updateString();
     }
 }
 
+ChordNamer::Note::Note(const int32_t absoluteNote, const Accidental accidental,
+                       const Accidental preferredAccidental): absoluteNote(absoluteNote), accidental(accidental),
+                                                              preferredAccidental(preferredAccidental) {
+    if (!validate(pack(absoluteNote, accidental)) || absoluteNote < 0 || absoluteNote >= 12) {
+        throw std::invalid_argument("Invalid note: " + std::to_string(absoluteNote));
+    }
+}
+
+ChordNamer::Note ChordNamer::Note::unpack(const PackedNote packed, const Accidental preferredAccidental) {
+    return {packed & 0x0F, static_cast<Accidental>((packed >> 4) - 2), preferredAccidental};
+}
+
+ChordNamer::Note &ChordNamer::Note::assign(const PackedNote packed) {
+    if (!validate(packed)) {
+        throw std::invalid_argument("Invalid note: " + std::to_string(packed));
+    }
+    absoluteNote = packed & 0x0F;
+    accidental = static_cast<Accidental>((packed >> 4) - 2);
+    return *this;
+}
+
 ChordNamer::Note &ChordNamer::Note::shiftSemitone(const int32_t semitones, const Accidental defaultAccidental) {
     const uint32_t absShift = (semitones > 0) ? semitones : 12 + semitones;
     absoluteNote = static_cast<int32_t>(absoluteNote + absShift) % 12;
@@ -88,7 +138,6 @@ ChordNamer::Note &ChordNamer::Note::shiftSemitone(const int32_t semitones, const
             accidental = defaultAccidental;
     }
 
-    updateString();
     return *this;
 }
 
@@ -132,16 +181,27 @@ ChordNamer::Note &ChordNamer::Note::respell() {
             break;
     }
 
-    updateString();
     return *this;
 }
 
 std::string ChordNamer::Note::toString() const {
-    return strNote;
+    return toCString();
 }
 
 const char *ChordNamer::Note::toCString() const {
-    return strNote.c_str();
+    const char *name = noteNames.names[absoluteNote][accidental - DOUBLE_FLAT];
+    if (name[0] == '\0') {
+        //the accidental does not spell this note (explicit accidental given to shiftSemitone),
+        //fall back to the preferred accidental, then to a natural or sharp note
+        name = noteNames.names[absoluteNote][preferredAccidental - DOUBLE_FLAT];
+        if (name[0] == '\0') {
+            name = noteNames.names[absoluteNote][NATURAL - DOUBLE_FLAT];
+        }
+        if (name[0] == '\0') {
+            name = noteNames.names[absoluteNote][SHARP - DOUBLE_FLAT];
+        }
+    }
+    return name;
 }
 
 bool ChordNamer::Note::validate(const std::string &strNote) {
@@ -186,6 +246,75 @@ bool ChordNamer::Note::validate(const std::string &strNote) {
     return false;
 }
 
+bool ChordNamer::Note::validate(const PackedNote packed) {
+    //the note is valid if removing the accidental lands on a natural note
+    const static bool isNatural[12] = {true, false, true, true, false, true, false, true, true, false, true, false};
+
+    const uint32_t absolute = packed & 0x0F;
+    const int32_t accidental = (packed >> 4) - 2;
+    if (absolute >= 12 || accidental < DOUBLE_FLAT || accidental > DOUBLE_SHARP) {
+        return false;
+    }
+    return isNatural[(absolute - accidental + 12) % 12];
+}
+
+bool ChordNamer::Note::parse(const std::string_view str, PackedNote &packed) noexcept {
+    const static int indexMap[7] = {0 /*A*/, 2 /*B*/, 3 /*C*/, 5 /*D*/, 7 /*E*/, 8 /*F*/, 10 /*G*/};
+
+    auto letterIndex = [](const char c) {
+        if (c >= 'a' && c <= 'g') return c - 'a';
+        if (c >= 'A' && c <= 'G') return c - 'A';
+        return -1;
+    };
+
+    int32_t letter;
+    int32_t accidental = NATURAL;
+
+    if (str.empty()) {
+        return false;
+    }
+    if ((letter = letterIndex(str[0])) != -1) {
+        //accidental is after note (b,bb,#,x)
+        const std::string_view suffix = str.substr(1);
+        if (suffix == "b") accidental = FLAT;
+        else if (suffix == "bb") accidental = DOUBLE_FLAT;
+        else if (suffix == "#") accidental = SHARP;
+        else if (suffix == "x") accidental = DOUBLE_SHARP;
+        else if (!suffix.empty()) return false;
+    } else {
+        //accidental is before note (LDP-style) (-,--,+,x)
+        const std::string_view prefix = str.substr(0, str.size() - 1);
+        if ((letter = letterIndex(str.back())) == -1) return false;
+        if (prefix == "-") accidental = FLAT;
+        else if (prefix == "--") accidental = DOUBLE_FLAT;
+        else if (prefix == "+") accidental = SHARP;
+        else if (prefix == "x") accidental = DOUBLE_SHARP;
+        else return false;
+    }
+
+    packed = pack((indexMap[letter] + accidental + 12) % 12, static_cast<Accidental>(accidental));
+    return true;
+}
+
+bool ChordNamer::Note::parseList(const std::string_view str, std::vector<PackedNote> &notes) {
+    const size_t before = notes.size();
+    size_t start = 0;
+    for (size_t i = 0; i <= str.size(); i++) {
+        if (i == str.size() || str[i] == ' ' || str[i] == ',' || str[i] == '\r' || str[i] == '\t') {
+            if (i > start) {
+                PackedNote packed;
+                if (!parse(str.substr(start, i - start), packed)) {
+                    notes.resize(before);
+                    return false;
+                }
+                notes.push_back(packed);
+            }
+            start = i + 1;
+        }
+    }
+    return true;
+}
+
 uint32_t ChordNamer::Note::getDistanceTo(const Note &right) const {
     return (right.absoluteNote - this->absoluteNote + 12) % 12;
 }
@@ -222,50 +351,10 @@ std::vector<uint32_t> ChordNamer::Note::getUniqueIndexes(const std::vector<Note>
     return uniqueIndex;
 }
 
-void ChordNamer::Note::updateString() {
-    //the magic happens here
-
-    switch ((absoluteNote - accidental + 12) % 12) {
-        case 0:
-            strNote = "A";
-            break;
-        case 2:
-            strNote = "B";
-            break;
-        case 3:
-            strNote = "C";
-            break;
-        case 5:
-            strNote = "D";
-            break;
-        case 7:
-            strNote = "E";
-            break;
-        case 8:
-            strNote = "F";
-            break;
-        case 10:
-            strNote = "G";
-            break;
-        default:
-            break;
-    }
-
-    switch (accidental) {
-        case SHARP:
-            strNote += "#";
-            break;
-        case FLAT:
-            strNote += "b";
-            break;
-        case DOUBLE_SHARP:
-            strNote += "x";
-            break;
-        case DOUBLE_FLAT:
-            strNote += "bb";
-            break;
-        case NATURAL:
-        default:
-            break;
+uint32_t ChordNamer::Note::getPitchClassMask(const std::vector<Note> &allNotes) {
+    uint32_t mask = 0;
+    for (const Note &note: allNotes) {
+        mask |= 1u << note.absoluteNote;
     }
+    return mask;
 }
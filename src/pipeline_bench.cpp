@@ -0,0 +1,134 @@
+/*
+Event-to-name latency of NamingPipeline under burst load.
+
+An input thread sends bursts of note on/off events as fast as it can, then
+waits; the pipeline worker names the held notes; a consumer thread takes every
+result and measures the time since the oldest event it accounts for, while a UI
+thread polls the latest-value slot once per millisecond.
+Reports the p50/p99/p999 latencies.
+
+usage: chordnamer_PipelineBench [bursts] [events per burst] [gap between bursts in us]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "naming_pipeline.h"
+
+using namespace ChordNamer;
+
+namespace {
+	const uint8_t sampleChords[][5] = {
+		{60, 64, 67, 0, 0}, {57, 60, 64, 67, 0}, {50, 54, 57, 60, 0}, {43, 59, 62, 65, 69},
+		{52, 56, 59, 62, 65}, {58, 62, 65, 68, 72}, {48, 51, 54, 57, 0}, {53, 57, 60, 64, 67},
+	};
+
+	uint64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	double percentile(const std::vector<uint64_t> &sorted, const double p) {
+		if (sorted.empty()) {
+			return 0;
+		}
+		const auto index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+		return static_cast<double>(sorted[index]) / 1000.0;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	const size_t burstCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+	const size_t burstSize = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 16;
+	const auto gap = std::chrono::microseconds((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 100);
+
+	const NamingEngine engine;
+	NamingPipeline pipeline(engine);
+
+	std::atomic<bool> done{false};
+	std::vector<uint64_t> latencies;
+	latencies.reserve(burstCount * burstSize);
+	size_t uiUpdates = 0;
+
+	std::thread consumer([&]() {
+		NamingPipeline::Result result;
+		while (true) {
+			const bool finished = done.load(std::memory_order_acquire);
+			bool any = false;
+			while (pipeline.pop(result)) {
+				latencies.push_back(now() - result.timestamp);
+				any = true;
+			}
+			if (finished && !any) {
+				break;
+			}
+			if (!any) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	std::thread ui([&]() {
+		NamingPipeline::Result result;
+		while (!done.load(std::memory_order_acquire)) {
+			uiUpdates += pipeline.latest(result);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+
+	pipeline.start();
+
+	//input thread: releases the previous chord and plays the next one, burstSize events at a time
+	size_t pushed = 0;
+	size_t rejected = 0;
+	size_t chord = 0;
+	size_t position = 0;
+	bool releasing = false;
+
+	const auto begin = std::chrono::steady_clock::now();
+	for (size_t b = 0; b < burstCount; b++) {
+		const auto next = std::chrono::steady_clock::now() + gap;
+		for (size_t e = 0; e < burstSize; e++) {
+			const uint8_t *notes = sampleChords[chord];
+			const NamingPipeline::NoteEvent event{now(), notes[position], static_cast<uint8_t>(releasing ? 0 : 100)};
+			if (pipeline.push(event)) {
+				pushed++;
+			} else {
+				rejected++;
+			}
+
+			position++;
+			if (position == 5 || notes[position] == 0) {
+				position = 0;
+				if (releasing) {
+					chord = (chord + 1) % (sizeof(sampleChords) / sizeof(sampleChords[0]));
+				}
+				releasing = !releasing;
+			}
+		}
+		std::this_thread::sleep_until(next);
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	pipeline.stop();
+	done.store(true, std::memory_order_release);
+	consumer.join();
+	ui.join();
+
+	std::sort(latencies.begin(), latencies.end());
+
+	printf("Events: %zu pushed, %zu rejected (queue full) in %.3f s\n", pushed, rejected, seconds);
+	printf("Results: %zu, %llu dropped (queue full), %zu UI updates\n", latencies.size(),
+	       static_cast<unsigned long long>(pipeline.droppedResults()), uiUpdates);
+	printf("Latency (us): p50 %.2f  p99 %.2f  p999 %.2f  max %.2f\n", percentile(latencies, 0.50),
+	       percentile(latencies, 0.99), percentile(latencies, 0.999),
+	       latencies.empty() ? 0.0 : static_cast<double>(latencies.back()) / 1000.0);
+
+	return 0;
+}
@@ -0,0 +1,23 @@
+#include <stdexcept>
+
+#include "chord.h"
+#include "quality_table.h"
+
+static_assert(ChordNamer::QualityTable::STRIDE == ChordNamer::Chord::MAX_QUALITY_LENGTH + 1);
+
+ChordNamer::QualityTable::QualityTable() : qualities(MASK_COUNT * STRIDE, '\0'), lengths(MASK_COUNT),
+                                           rankings(MASK_COUNT), suspensions(MASK_COUNT) {
+	for (uint32_t mask = 0; mask < MASK_COUNT; mask++) {
+		int32_t ranking;
+		bool suspended;
+		const int32_t length = Chord::getChordQualityFromMask(mask, &qualities[mask * STRIDE], STRIDE, &ranking,
+		                                                      &suspended);
+		if (length < 0) {
+			throw std::length_error("Chord quality does not fit in the quality table");
+		}
+
+		lengths[mask] = static_cast<uint8_t>(length);
+		rankings[mask] = static_cast<int8_t>(ranking);
+		suspensions[mask] = suspended;
+	}
+}
@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "reharmonizer.h"
+
+namespace {
+	constexpr uint32_t FULL = 0xFFF;
+
+	//every note of mask moved by one semitone up and down, plus the notes themselves
+	constexpr uint32_t grow(const uint32_t mask) {
+		return (mask | (mask << 1) | (mask >> 1) | (mask << 11) | (mask >> 11)) & FULL;
+	}
+
+	/*
+	popcount(a) + popcount(b) for words holding 5 fields of 12 bits, with shifts, masks
+	and adds only so that the kernel loop vectorizes without a popcount instruction
+	*/
+	constexpr uint32_t bitCountSum(uint64_t a, uint64_t b) {
+		a -= (a >> 1) & 0x5555555555555555ull;
+		b -= (b >> 1) & 0x5555555555555555ull;
+		a = (a & 0x3333333333333333ull) + ((a >> 2) & 0x3333333333333333ull);
+		b = (b & 0x3333333333333333ull) + ((b >> 2) & 0x3333333333333333ull);
+		uint64_t sum = a + b; //at most 8 per nibble
+		sum = (sum & 0x0F0F0F0F0F0F0F0Full) + ((sum >> 4) & 0x0F0F0F0F0F0F0F0Full);
+		sum += sum >> 8;
+		sum += sum >> 16;
+		sum += sum >> 32;
+		return static_cast<uint32_t>(sum & 0xFF);
+	}
+
+	void checkTarget(const int32_t note) {
+		if (note < -1 || note > 11) {
+			throw std::invalid_argument("Invalid target note: " + std::to_string(note));
+		}
+	}
+}
+
+ChordNamer::Reharmonizer::Reharmonizer(const NamingEngine &engine) : Reharmonizer(engine, Options()) {
+}
+
+ChordNamer::Reharmonizer::Reharmonizer(const NamingEngine &engine, const Options &options) : engine(engine),
+	options(options) {
+	this->options.minNotes = std::max<uint32_t>(options.minNotes, 2); //see DILATIONS
+	this->options.beamWidth = std::clamp<uint32_t>(options.beamWidth, 1, UINT16_MAX); //beam indexes are 16 bits
+
+	NamingEngine::Candidate candidates[NamingEngine::MAX_CANDIDATES];
+	const Spelling spelling = Spelling::sharps();
+
+	for (uint32_t mask = 1; mask <= FULL; mask++) {
+		const auto noteCount = static_cast<uint32_t>(std::popcount(mask));
+		if (noteCount < this->options.minNotes || noteCount > this->options.maxNotes) {
+			continue;
+		}
+
+		State state = makeState(mask);
+		std::array<int8_t, 12> rankings;
+		rankings.fill(-1);
+
+		for (uint32_t bass = 0; bass < 12; bass++) {
+			if (!(mask & (1u << bass))) {
+				continue;
+			}
+			//bass first, then the other notes going up from it
+			PackedNote notes[12];
+			uint32_t count = 0;
+			for (uint32_t i = 0; i < 12; i++) {
+				const uint32_t note = (bass + i) % 12;
+				if (mask & (1u << note)) {
+					notes[count++] = spelling.spell(note);
+				}
+			}
+			if (engine.evaluate(notes, count, candidates) <= 0) {
+				continue;
+			}
+			rankings[bass] = static_cast<int8_t>(std::min<int32_t>(candidates[0].ranking, INT8_MAX));
+			if (state.bestBass < 0 || rankings[bass] < state.bestRanking) {
+				state.bestBass = static_cast<int8_t>(bass);
+				state.bestRanking = rankings[bass];
+			}
+		}
+
+		if (state.bestBass >= 0 && state.bestRanking <= options.maxRanking) {
+			vocabulary.push_back(state);
+			bassRankings.push_back(rankings);
+		}
+	}
+}
+
+ChordNamer::Reharmonizer::State ChordNamer::Reharmonizer::makeState(const uint32_t mask) {
+	State state{0, 0, static_cast<uint16_t>(mask), -1, -1};
+
+	uint32_t dilated = mask;
+	for (uint32_t d = 0; d < DILATIONS; d++) {
+		state.replicated |= static_cast<uint64_t>(mask) << (12 * d);
+		state.notDilated |= static_cast<uint64_t>(~dilated & FULL) << (12 * d);
+		dilated = grow(dilated);
+	}
+	return state;
+}
+
+uint32_t ChordNamer::Reharmonizer::voiceLeadingCost(uint32_t from, uint32_t to) {
+	from &= FULL;
+	to &= FULL;
+	if (from == 0 || to == 0) {
+		return 0;
+	}
+
+	//a note at distance k from the other chord is outside its first k dilations
+	uint32_t cost = 0;
+	uint32_t fromDilated = from;
+	uint32_t toDilated = to;
+	for (uint32_t d = 0; d < 6; d++) {
+		cost += std::popcount(to & ~fromDilated) + std::popcount(from & ~toDilated);
+		fromDilated = grow(fromDilated);
+		toDilated = grow(toDilated);
+	}
+	return cost;
+}
+
+std::vector<ChordNamer::Reharmonizer::Step> ChordNamer::Reharmonizer::solve(const std::vector<Target> &targets) const {
+	struct Node {
+		uint16_t state; //index in the vocabulary
+		uint16_t parent; //index in the previous beam
+		int8_t bass;
+		uint32_t cost;
+	};
+
+	std::vector<std::vector<Node> > beams(targets.size());
+
+	//previous beam in structure-of-arrays form for the transition kernel
+	std::vector<uint64_t> previousReplicated;
+	std::vector<uint64_t> previousNotDilated;
+	std::vector<uint32_t> previousCost;
+	std::vector<uint32_t> costs;
+
+	for (size_t t = 0; t < targets.size(); t++) {
+		const Target &target = targets[t];
+		checkTarget(target.melody);
+		checkTarget(target.bass);
+
+		const uint32_t required = (target.melody >= 0 ? 1u << target.melody : 0)
+		                          | (target.bass >= 0 ? 1u << target.bass : 0);
+
+		const size_t previousCount = (t == 0) ? 0 : beams[t - 1].size();
+		previousReplicated.resize(previousCount);
+		previousNotDilated.resize(previousCount);
+		previousCost.resize(previousCount);
+		costs.resize(previousCount);
+		for (size_t i = 0; i < previousCount; i++) {
+			const Node &node = beams[t - 1][i];
+			previousReplicated[i] = vocabulary[node.state].replicated;
+			previousNotDilated[i] = vocabulary[node.state].notDilated;
+			previousCost[i] = node.cost;
+		}
+
+		std::vector<Node> &beam = beams[t];
+		for (size_t v = 0; v < vocabulary.size(); v++) {
+			const State &state = vocabulary[v];
+			if ((state.mask & required) != required) {
+				continue;
+			}
+
+			const int8_t bass = (target.bass >= 0) ? static_cast<int8_t>(target.bass) : state.bestBass;
+			const int32_t ranking = (target.bass >= 0) ? bassRankings[v][target.bass] : state.bestRanking;
+			if (ranking < 0) {
+				continue;
+			}
+
+			Node node{static_cast<uint16_t>(v), 0, bass, options.rankingWeight * static_cast<uint32_t>(ranking)};
+
+			if (previousCount > 0) {
+				//transition kernel: no branch, no table, one bit count per pair
+				const uint64_t replicated = state.replicated;
+				const uint64_t notDilated = state.notDilated;
+				const uint32_t weight = options.voiceLeadingWeight;
+				for (size_t i = 0; i < previousCount; i++) {
+					const uint32_t distance = bitCountSum(replicated & previousNotDilated[i],
+					                                      previousReplicated[i] & notDilated);
+					costs[i] = previousCost[i] + weight * distance;
+				}
+				const auto best = std::min_element(costs.begin(), costs.end());
+				node.parent = static_cast<uint16_t>(best - costs.begin());
+				node.cost += *best;
+			}
+
+			beam.push_back(node);
+		}
+
+		if (beam.empty()) {
+			return {};
+		}
+
+		//pruning: only the beamWidth cheapest states go on to the next step
+		if (beam.size() > options.beamWidth) {
+			std::nth_element(beam.begin(), beam.begin() + options.beamWidth, beam.end(),
+			                 [](const Node &a, const Node &b) {
+				                 return a.cost < b.cost;
+			                 });
+			beam.resize(options.beamWidth);
+		}
+	}
+
+	std::vector<Step> path(targets.size());
+	if (targets.empty()) {
+		return path;
+	}
+
+	const std::vector<Node> &last = beams.back();
+	size_t index = std::min_element(last.begin(), last.end(), [](const Node &a, const Node &b) {
+		return a.cost < b.cost;
+	}) - last.begin();
+
+	for (size_t t = targets.size(); t-- > 0;) {
+		const Node &node = beams[t][index];
+		path[t] = {vocabulary[node.state].mask, node.bass, node.cost};
+		index = node.parent;
+	}
+	return path;
+}
+
+std::string ChordNamer::Reharmonizer::name(const Step &step, const Spelling &spelling) const {
+	PackedNote notes[12];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 12; i++) {
+		const uint32_t note = (step.bass + i) % 12;
+		if (step.mask & (1u << note)) {
+			notes[count++] = spelling.spell(note);
+		}
+	}
+
+	NamingEngine::Candidate candidates[NamingEngine::MAX_CANDIDATES];
+	char buffer[NamingEngine::MAX_NAME_LENGTH];
+	if (engine.evaluate(notes, count, candidates) <= 0
+	    || engine.format(notes, candidates[0], buffer, sizeof(buffer)) < 0) {
+		return "";
+	}
+	return buffer;
+}
@@ -0,0 +1,68 @@
+#include <initializer_list>
+
+#include "scale.h"
+
+namespace {
+	constexpr uint32_t scaleMask(std::initializer_list<uint32_t> semitones) {
+		uint32_t mask = 0;
+		for (const uint32_t semitone: semitones) {
+			mask |= 1u << semitone;
+		}
+		return mask;
+	}
+}
+
+const ChordNamer::ScaleMembership::Scale ChordNamer::ScaleMembership::catalog[SCALE_COUNT] = {
+	{"ionian", scaleMask({0, 2, 4, 5, 7, 9, 11})},
+	{"dorian", scaleMask({0, 2, 3, 5, 7, 9, 10})},
+	{"phrygian", scaleMask({0, 1, 3, 5, 7, 8, 10})},
+	{"lydian", scaleMask({0, 2, 4, 6, 7, 9, 11})},
+	{"mixolydian", scaleMask({0, 2, 4, 5, 7, 9, 10})},
+	{"aeolian", scaleMask({0, 2, 3, 5, 7, 8, 10})},
+	{"locrian", scaleMask({0, 1, 3, 5, 6, 8, 10})},
+	{"harmonic minor", scaleMask({0, 2, 3, 5, 7, 8, 11})},
+	{"melodic minor", scaleMask({0, 2, 3, 5, 7, 9, 11})},
+	{"lydian dominant", scaleMask({0, 2, 4, 6, 7, 9, 10})},
+	{"altered", scaleMask({0, 1, 3, 4, 6, 8, 10})},
+	{"major pentatonic", scaleMask({0, 2, 4, 7, 9})},
+	{"minor pentatonic", scaleMask({0, 3, 5, 7, 10})},
+	{"blues", scaleMask({0, 3, 5, 6, 7, 10})},
+	{"whole tone", scaleMask({0, 2, 4, 6, 8, 10})},
+	{"diminished", scaleMask({0, 2, 3, 5, 6, 8, 9, 11})},
+};
+
+ChordNamer::ScaleMembership::ScaleMembership() : table(MASK_COUNT) {
+	for (uint32_t scale = 0; scale < SCALE_COUNT; scale++) {
+		for (uint32_t key = 0; key < KEY_COUNT; key++) {
+			const uint32_t intervals = catalog[scale].intervals;
+			const uint32_t notes = ((intervals << key) | (intervals >> (12 - key))) & 0xFFF;
+			const uint32_t bit = scale * KEY_COUNT + key;
+
+			//every subset of the scale is contained in it, walk them all
+			uint32_t subset = notes;
+			while (true) {
+				table[subset].set(bit);
+				if (subset == 0) {
+					break;
+				}
+				subset = (subset - 1) & notes;
+			}
+		}
+	}
+}
+
+void ChordNamer::ScaleMembership::lookup(const uint32_t *pitchClassMasks, const size_t count, ScaleSet *out) const {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = lookup(pitchClassMasks[i]);
+	}
+}
+
+ChordNamer::ScaleMembership::ScaleSet ChordNamer::ScaleMembership::common(const uint32_t *pitchClassMasks,
+                                                                        const size_t count) const {
+	ScaleSet scales;
+	scales.set();
+	for (size_t i = 0; i < count; i++) {
+		scales &= lookup(pitchClassMasks[i]);
+	}
+	return scales;
+}
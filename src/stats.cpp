@@ -0,0 +1,120 @@
+/*
+Corpus statistics over the simplest name of every chord.
+
+Reads one chord per line from stdin, in the same format as the demo
+("C E G" or "C,E,G"); an empty line ends a piece. Prints quality frequencies,
+inversion and slash-chord rates, the ranking distribution, the most frequent
+names and the most frequent transitions between consecutive chords.
+Everything but the names is independent of the thread count. Names come from a
+Space-Saving sketch: when a corpus has more distinct names than the sketch
+holds, their counts are estimates (within the printed error) that depend on how
+the corpus was split between threads.
+
+usage: chordnamer_Stats [threads] [top k] < corpus.txt
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "corpus_stats.h"
+
+using namespace ChordNamer;
+
+namespace {
+	double percent(const uint64_t part, const uint64_t total) {
+		return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	const uint32_t threadCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 0;
+	const size_t topK = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+	std::ios::sync_with_stdio(false);
+
+	std::vector<PackedNote> notes;
+	std::vector<uint32_t> offsets(1, 0);
+	std::vector<uint8_t> pieceStarts;
+	bool newPiece = true;
+
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		if (line.find_first_not_of(" \t\r,") == std::string::npos) {
+			newPiece = true;
+			continue;
+		}
+		//an invalid chord is stored empty, it and single notes are counted as failures
+		Note::parseList(line, notes);
+		offsets.push_back(static_cast<uint32_t>(notes.size()));
+		pieceStarts.push_back(newPiece);
+		newPiece = false;
+	}
+
+	const NamingEngine engine;
+	const size_t chordCount = offsets.size() - 1;
+
+	const auto begin = std::chrono::steady_clock::now();
+	const CorpusSummary summary = CorpusStats::analyze(engine, notes.data(), offsets.data(), chordCount,
+	                                                   pieceStarts.data(), threadCount);
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	printf("Chords: %llu named, %llu failed (%.3f s)\n", static_cast<unsigned long long>(summary.chords),
+	       static_cast<unsigned long long>(summary.failures), seconds);
+	printf("Inversions: %.2f%%\n", percent(summary.inversions, summary.chords));
+	printf("Slash chords: %.2f%%\n", percent(summary.slashChords, summary.chords));
+
+	printf("\nRanking distribution:\n");
+	for (size_t i = 0; i < summary.rankingCounts.size(); i++) {
+		if (summary.rankingCounts[i] != 0) {
+			printf("  %2zu%s %6.2f%%\n", i, i == CorpusSummary::MAX_RANKING ? "+" : " ",
+			       percent(summary.rankingCounts[i], summary.chords));
+		}
+	}
+
+	std::vector<uint32_t> qualities;
+	for (uint32_t mask = 0; mask < summary.qualityCounts.size(); mask++) {
+		if (summary.qualityCounts[mask] != 0) {
+			qualities.push_back(mask);
+		}
+	}
+	std::sort(qualities.begin(), qualities.end(), [&summary](const uint32_t a, const uint32_t b) {
+		const uint64_t countA = summary.qualityCounts[a];
+		const uint64_t countB = summary.qualityCounts[b];
+		return countA > countB || (countA == countB && a < b);
+	});
+
+	printf("\nQualities:\n");
+	for (size_t i = 0; i < qualities.size() && i < topK; i++) {
+		const char *quality = engine.getQualityTable().quality(qualities[i]);
+		printf("  %-30s %6.2f%%\n", quality[0] == '\0' ? "(major)" : quality,
+		       percent(summary.qualityCounts[qualities[i]], summary.chords));
+	}
+
+	printf("\nNames:\n");
+	for (const HeavyHitters::Counter &counter: summary.topNames.top(topK)) {
+		printf("  %-30s %llu (+/- %llu)\n", CorpusSummary::keyToName(engine, counter.key).c_str(),
+		       static_cast<unsigned long long>(counter.count), static_cast<unsigned long long>(counter.error));
+	}
+
+	std::vector<std::pair<uint64_t, uint64_t> > bigrams(summary.bigrams.begin(), summary.bigrams.end());
+	const size_t shown = std::min(topK, bigrams.size());
+	std::partial_sort(bigrams.begin(), bigrams.begin() + static_cast<std::ptrdiff_t>(shown), bigrams.end(),
+	                  [](const auto &a, const auto &b) {
+		                  //ties on the key, so the order does not depend on the hash table
+		                  return a.second > b.second || (a.second == b.second && a.first < b.first);
+	                  });
+
+	printf("\nTransitions:\n");
+	for (size_t i = 0; i < shown; i++) {
+		const std::string from = CorpusSummary::keyToName(engine, static_cast<uint32_t>(bigrams[i].first >> 32));
+		const std::string to = CorpusSummary::keyToName(engine, static_cast<uint32_t>(bigrams[i].first));
+		printf("  %-14s -> %-14s %llu\n", from.c_str(), to.c_str(), static_cast<unsigned long long>(bigrams[i].second));
+	}
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <iterator>
+
+#include "transpose.h"
+
+namespace {
+	constexpr ChordNamer::Spelling sharpSpelling = ChordNamer::Spelling::sharps();
+	constexpr ChordNamer::Spelling flatSpelling = ChordNamer::Spelling::flats();
+
+	//fills the table slots of invalid packed notes, fails Note::validate
+	constexpr ChordNamer::PackedNote INVALID_NOTE = 0xFF;
+
+	constexpr uint32_t normalizeShift(const int32_t semitones) {
+		return static_cast<uint32_t>(semitones % 12 + 12) % 12;
+	}
+
+	/*
+	Table indexed by the whole packed note, so that any invalid input byte maps to
+	INVALID_NOTE; valid ones go through spell(absolute note, accidental).
+	*/
+	template<typename Spell>
+	void fillTable(ChordNamer::PackedNote (&table)[256], const Spell &spell) {
+		using ChordNamer::Note;
+		std::fill(std::begin(table), std::end(table), INVALID_NOTE);
+		for (uint32_t absolute = 0; absolute < 12; absolute++) {
+			for (int32_t accidental = Note::DOUBLE_FLAT; accidental <= Note::DOUBLE_SHARP; accidental++) {
+				const auto packed = Note::pack(absolute, static_cast<Note::Accidental>(accidental));
+				if (Note::validate(packed)) {
+					table[packed] = spell(absolute, accidental);
+				}
+			}
+		}
+	}
+}
+
+void ChordNamer::Transposition::transpose(const PackedNote *in, PackedNote *out, const size_t count,
+                                          const int32_t semitones, const Spelling &spelling) {
+	const uint32_t shift = normalizeShift(semitones);
+
+	//shift and spell every valid packed note once so the loop is a single lookup per note
+	PackedNote shifted[256];
+	fillTable(shifted, [&](const uint32_t absolute, int32_t) {
+		return spelling.spell((absolute + shift) % 12);
+	});
+
+	for (size_t i = 0; i < count; i++) {
+		out[i] = shifted[in[i]];
+	}
+}
+
+void ChordNamer::Transposition::transpose(const PackedNote *in, PackedNote *out, const size_t count,
+                                          const int32_t semitones) {
+	const uint32_t shift = normalizeShift(semitones);
+
+	//flat source notes are spelled with flats, the others with sharps
+	PackedNote shifted[256];
+	fillTable(shifted, [&](const uint32_t absolute, const int32_t accidental) {
+		const Spelling &spelling = (accidental < Note::NATURAL) ? flatSpelling : sharpSpelling;
+		return spelling.spell((absolute + shift) % 12);
+	});
+
+	for (size_t i = 0; i < count; i++) {
+		out[i] = shifted[in[i]];
+	}
+}
+
+void ChordNamer::Transposition::respell(PackedNote *notes, const size_t count, const Spelling &spelling) {
+	transpose(notes, notes, count, 0, spelling);
+}
+
+size_t ChordNamer::Transposition::transposeAndName(const NamingEngine &engine, const PackedNote *notes,
+                                                   const uint32_t *chordOffsets, const size_t chordCount,
+                                                   const int32_t semitones, const Spelling &spelling,
+                                                   PackedNote *transposed, char *names, const size_t nameStride,
+                                                   int32_t *rankings) {
+	if (chordCount == 0) {
+		return 0;
+	}
+
+	//chords are stored back to back, so the whole buffer is transposed in one pass
+	transpose(notes + chordOffsets[0], transposed + chordOffsets[0], chordOffsets[chordCount] - chordOffsets[0],
+	          semitones, spelling);
+
+	return engine.nameBatch(transposed, chordOffsets, chordCount, names, nameStride, rankings);
+}
@@ -0,0 +1,241 @@
+#include <bit>
+#include <cstring>
+
+#include "fixed_string.h"
+#include "interval.h"
+#include "tuning.h"
+
+namespace {
+	//"[k]" label of every step, used for steps that have no 12-TET interval name
+	template<uint32_t N>
+	struct StepLabels {
+		char labels[N][5] = {};
+
+		constexpr StepLabels() {
+			for (uint32_t step = 0; step < N; step++) {
+				uint32_t pos = 0;
+				labels[step][pos++] = '[';
+				if (step >= 10) {
+					labels[step][pos++] = static_cast<char>('0' + step / 10);
+				}
+				labels[step][pos++] = static_cast<char>('0' + step % 10);
+				labels[step][pos] = ']';
+			}
+		}
+	};
+
+	template<uint32_t N>
+	constexpr StepLabels<N> stepLabels;
+}
+
+template<uint32_t N>
+void ChordNamer::QualityEvaluator<N>::getIntervalNames(const Mask mask, const char *names[N],
+                                                       const bool chordMode) noexcept {
+	using T = TuningType;
+	const static char *defaultNames[12] = {"1", "b9", "9", "b3", "3", "11", "b5", "5", "#5", "6", "b7", "7"};
+
+	for (uint32_t step = 0; step < N; step++) {
+		names[step] = stepLabels<N>.labels[step];
+	}
+	for (uint32_t semitone = 0; semitone < 12; semitone++) {
+		names[T::steps[semitone]] = defaultNames[semitone];
+	}
+
+	auto exist = [mask](const uint32_t semitone) {
+		return (mask & T::bit(semitone)) != 0;
+	};
+
+	//below compare with semitone interval
+	//if 3 and b3 is present, b3 becomes #9
+	//if 5 and (b5 || #5) is present, (#11 || b13) is used
+	//if 7 is present, 6 becomes 13
+	//if b3/3 is NOT present, 4 is used instead of 11
+	//if both b3/3 and 4 are NOT present, then 2 is used instead of 9
+	//if b3 and b5 and 6 are present (diminished) , then 6/13 becomes 7 and b6/b13 becomes 13
+
+	bool thirdPresent = false;
+
+	if (exist(M3)) {
+		//major 3rd
+		names[T::steps[m3]] = "#9";
+		thirdPresent = true;
+	}
+	if (exist(P5)) {
+		//perfect 5th
+		names[T::steps[d5]] = "#11";
+		names[T::steps[m6]] = "b13";
+	}
+	if (exist(m7) || exist(M7)) {
+		//minor or major 7th
+		names[T::steps[M6]] = "13";
+	}
+	if (exist(m3)) {
+		//minor 3rd
+		thirdPresent = true;
+		if (exist(d5) && exist(d7) && !exist(m7) && !exist(M7)) {
+			//full diminished chord
+			if (chordMode) {
+				names[T::steps[d7]] = "7";
+				names[T::steps[m6]] = "13";
+			} else {
+				names[T::steps[d7]] = "bb7";
+				names[T::steps[m6]] = "b13";
+			}
+		}
+	}
+
+	if (!thirdPresent) {
+		//sus chord
+		names[T::steps[P4]] = "4";
+
+		if (!exist(P4))
+			names[T::steps[M2]] = "2";
+	}
+}
+
+template<uint32_t N>
+int32_t ChordNamer::QualityEvaluator<N>::evaluate(const Mask mask, char *buffer, const size_t capacity,
+                                                  int32_t *ranking, bool *suspended) noexcept {
+	using T = TuningType;
+	using QualityString = FixedString<MAX_QUALITY_LENGTH>;
+
+	uint32_t extStack[4] = {M7, M9, P11, M13}; //default 7 9 11 13
+
+	const char *intervalList[N];
+	getIntervalNames(mask, intervalList, true);
+
+	const char *additional[N];
+	uint32_t additionalCount = 0;
+
+	QualityString quality;
+	const char *sus = "";
+
+	bool isdim = false;
+
+	//notes not checked yet, every check clears the bit it looked at
+	Mask remaining = mask & T::FULL;
+
+	auto exist = [&remaining](const uint32_t semitone) {
+		return (remaining & T::bit(semitone)) != 0;
+	};
+	auto check = [&remaining](const uint32_t semitone) {
+		const bool ret = (remaining & T::bit(semitone)) != 0;
+		remaining &= static_cast<Mask>(~T::bit(semitone));
+		return ret;
+	};
+	auto isAltered = [&exist]() {
+		if (exist(M3) && exist(A5) && !(exist(m2) || exist(A2) || exist(d5))) {
+			return false; //only #5 is present, so is aug chord
+		}
+		return (exist(m2) || exist(A2) || exist(d5) || exist(A5));
+	};
+
+	if (check(M3)) {
+		//major chord
+		if (!isAltered() && check(A5)) {
+			//augmented chord
+			quality.append("aug");
+		}
+		check(P5);
+	} else if (check(m3)) {
+		//minor chord
+
+		if (!check(P5) && check(d5)) {
+			//dim chord
+			isdim = true;
+
+			if (exist(m7)) {
+				//mXb5 (halfdim)
+				quality.append("m");
+				additional[additionalCount++] = "b5";
+			} else {
+				quality.append("dim"); //dim
+			}
+		} else {
+			quality.append("m"); //normal minor chord
+		}
+	} else {
+		//suspended chord
+		if (check(P4)) {
+			sus = "sus4";
+		} else if (check(M2)) {
+			sus = "sus2";
+		} else if (check(P5)) {
+			quality.append("5");
+		} else {
+			additional[additionalCount++] = "omit3";
+		}
+		check(P5);
+	}
+
+	//extensions
+	QualityString extension;
+	bool hasExtension = true;
+	if (check(M7)) {
+		//maj7
+		extension.append("maj");
+	} else if (check(m7)) {
+		//dom7
+		//nothing
+	} else if (isdim && check(d7)) {
+		//dim7
+		extStack[0] = d7; //dim7 == maj6
+		extStack[3] = m6; //change 13 to b13
+	} else {
+		hasExtension = false;
+	}
+
+	if (hasExtension) {
+		uint32_t highest = extStack[0];
+		for (int32_t i = 1; i < 4; i++) {
+			if (check(extStack[i])) {
+				highest = extStack[i];
+			}
+		}
+		extension.append(intervalList[T::steps[highest]]);
+	} else if (check(M6)) {
+		//check 6 chords
+		quality.append("6");
+		if (check(M9)) {
+			//check 6/9 chord
+			quality.append("/9");
+		}
+	}
+
+	quality.append(extension);
+	quality.append(sus);
+
+	//dump all the rest of the notes not checked (leftover) to additional, lowest first
+	for (Mask rest = remaining & static_cast<Mask>(~Mask(1)); rest != 0; rest &= static_cast<Mask>(rest - 1)) {
+		additional[additionalCount++] = intervalList[std::countr_zero(rest)];
+	}
+
+	if (additionalCount == 1) {
+		if (std::strncmp(additional[0], "omit", 4) == 0)
+			quality.append("(").append(additional[0]).append(")");
+		else if (additional[0][0] == '#' || additional[0][0] == 'b')
+			quality.append(additional[0]);
+		else
+			quality.append("add").append(additional[0]);
+	} else if (additionalCount > 1) {
+		quality.append("(").append(additional[0]);
+		for (uint32_t i = 1; i < additionalCount; i++) {
+			quality.append(", ").append(additional[i]);
+		}
+		quality.append(")");
+	}
+
+	if (ranking != nullptr) {
+		//the lower the number, the simple the chord name is
+		*ranking = static_cast<int32_t>(additionalCount) + (sus[0] != '\0'); //sus has weight 1
+	}
+	if (suspended != nullptr) {
+		*suspended = sus[0] != '\0';
+	}
+	return quality.copyTo(buffer, capacity);
+}
+
+template class ChordNamer::QualityEvaluator<12>;
+template class ChordNamer::QualityEvaluator<19>;
+template class ChordNamer::QualityEvaluator<24>;
+template class ChordNamer::QualityEvaluator<31>;
@@ -0,0 +1,114 @@
+/*
+The real-time naming path must never allocate.
+
+Global operator new is replaced by a counting version; NamingEngine::nameRealtime
+(with every ranking policy) and Chord::getChordQualityFromMask run over random
+chords while counting is on, and the test fails on any allocation. The names of
+nameRealtime with DefaultRanking are also checked against Chord::chordNames.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "chord.h"
+#include "naming_engine.h"
+
+namespace {
+	bool counting = false;
+	size_t allocations = 0;
+
+	void *allocate(const size_t size) {
+		if (counting) {
+			allocations++;
+		}
+		void *pointer = std::malloc(size != 0 ? size : 1);
+		if (pointer == nullptr) {
+			throw std::bad_alloc();
+		}
+		return pointer;
+	}
+}
+
+void *operator new(const size_t size) {
+	return allocate(size);
+}
+
+void *operator new[](const size_t size) {
+	return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+	std::free(pointer);
+}
+
+using namespace ChordNamer;
+
+namespace {
+	constexpr uint32_t CHORD_COUNT = 200000;
+
+	template<typename Policy>
+	int32_t nameCounted(const PackedNote *notes, const size_t count, char *names, int32_t *rankings) {
+		counting = true;
+		const int32_t written = NamingEngine::nameRealtime<Policy>(notes, count, names, NamingEngine::MAX_NAME_LENGTH,
+		                                                           NamingEngine::MAX_CANDIDATES, rankings);
+		counting = false;
+		return written;
+	}
+}
+
+int main() {
+	std::mt19937 random(29);
+	constexpr int32_t naturals[7] = {0, 2, 3, 5, 7, 8, 10};
+
+	char names[NamingEngine::MAX_CANDIDATES][NamingEngine::MAX_NAME_LENGTH];
+	int32_t rankings[NamingEngine::MAX_CANDIDATES];
+	size_t mismatches = 0;
+
+	for (uint32_t c = 0; c < CHORD_COUNT; c++) {
+		const uint32_t count = 1 + random() % 7;
+		PackedNote notes[7];
+		std::vector<Note> chordNotes;
+		for (uint32_t i = 0; i < count; i++) {
+			const auto accidental = static_cast<Note::Accidental>(static_cast<int32_t>(random() % 5) - 2);
+			notes[i] = Note::pack((naturals[random() % 7] + accidental + 12) % 12, accidental);
+			chordNotes.push_back(Note::unpack(notes[i]));
+		}
+
+		nameCounted<RootlessRanking>(notes, count, &names[0][0], rankings);
+		nameCounted<PopRanking>(notes, count, &names[0][0], rankings);
+		nameCounted<JazzRanking>(notes, count, &names[0][0], rankings);
+		const int32_t written = nameCounted<DefaultRanking>(notes, count, &names[0][0], rankings);
+
+		char quality[Chord::MAX_QUALITY_LENGTH + 1];
+		int32_t ranking;
+		bool suspended;
+		counting = true;
+		Chord::getChordQualityFromMask(random() & 0xFFF, quality, sizeof(quality), &ranking, &suspended);
+		counting = false;
+
+		const Chord chord(chordNotes);
+		bool same = written == static_cast<int32_t>(chord.chordNames.size());
+		for (int32_t i = 0; same && i < written; i++) {
+			same = chord.chordNames[i] == names[i];
+		}
+		mismatches += !same;
+	}
+
+	printf("%u chords: %zu allocations, %zu names different from Chord\n", CHORD_COUNT, allocations, mismatches);
+	return (allocations == 0 && mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
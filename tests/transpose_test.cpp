@@ -0,0 +1,72 @@
+/*
+Transposition over every possible packed note byte.
+
+A valid note has to come out valid, shifted by the requested number of semitones
+(and, for the direction-keeping overload, never sharp if it was flat or flat if it was not); an invalid one
+(absolute note out of range, accidental bits above DOUBLE_SHARP, or an accidental
+that cannot spell the note) has to come out invalid, so that transposeAndName
+never names it.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "transpose.h"
+
+using namespace ChordNamer;
+
+int main() {
+	size_t failures = 0;
+
+	PackedNote all[256];
+	for (uint32_t i = 0; i < 256; i++) {
+		all[i] = static_cast<PackedNote>(i);
+	}
+
+	for (int32_t semitones = -13; semitones <= 13; semitones++) {
+		PackedNote spelled[256];
+		PackedNote kept[256];
+		Transposition::transpose(all, spelled, 256, semitones, Spelling::sharps());
+		Transposition::transpose(all, kept, 256, semitones);
+
+		for (uint32_t i = 0; i < 256; i++) {
+			const PackedNote in = all[i];
+			const bool valid = Note::validate(in);
+			const uint32_t expected = ((in & 0x0F) + semitones % 12 + 12) % 12;
+
+			for (const PackedNote out: {spelled[i], kept[i]}) {
+				if (Note::validate(out) != valid || (valid && (out & 0x0F) != expected)) {
+					printf("%+d semitones: 0x%02X -> 0x%02X\n", semitones, in, out);
+					failures++;
+				}
+			}
+			//flat notes stay flat or natural, the others sharp or natural
+			const bool flat = (in >> 4) < Note::NATURAL + 2;
+			if (valid && (flat ? (kept[i] >> 4) > Note::NATURAL + 2 : (kept[i] >> 4) < Note::NATURAL + 2)) {
+				printf("%+d semitones: 0x%02X -> 0x%02X changes the accidental direction\n", semitones, in, kept[i]);
+				failures++;
+			}
+		}
+	}
+
+	//C E G, then the same chord with one invalid note of each kind
+	const NamingEngine engine;
+	const PackedNote notes[] = {
+		Note::pack(3, Note::NATURAL), Note::pack(7, Note::NATURAL), Note::pack(10, Note::NATURAL),
+		Note::pack(3, Note::NATURAL), 0x0C, Note::pack(10, Note::NATURAL),
+		Note::pack(3, Note::NATURAL), 0x71, Note::pack(10, Note::NATURAL),
+		Note::pack(3, Note::NATURAL), Note::pack(1, Note::NATURAL), Note::pack(10, Note::NATURAL),
+	};
+	const uint32_t offsets[] = {0, 3, 6, 9, 12};
+	PackedNote transposed[12];
+	char names[4][NamingEngine::MAX_NAME_LENGTH];
+	const size_t named = Transposition::transposeAndName(engine, notes, offsets, 4, 2, Spelling::sharps(), transposed,
+	                                                     &names[0][0], NamingEngine::MAX_NAME_LENGTH);
+	if (named != 1) {
+		printf("transposeAndName named %zu chords instead of 1\n", named);
+		failures++;
+	}
+
+	printf("%zu failures\n", failures);
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}